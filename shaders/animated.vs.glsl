@@ -0,0 +1,22 @@
+#version 330 
+// Input attributes
+in vec3 in_position;
+in vec2 in_texcoord;
+
+// Passed to fragment shader
+out vec2 texcoord;
+
+// Application data
+uniform mat3 transform;
+uniform mat3 projection;
+
+// Window of the sprite sheet holding the current frame
+uniform vec2 uv_offset;
+uniform vec2 uv_scale;
+
+void main()
+{
+	texcoord = uv_offset + in_texcoord * uv_scale;
+	vec3 pos = projection * transform * vec3(in_position.xy, 1.0);
+	gl_Position = vec4(pos.xy, in_position.z, 1.0);
+}
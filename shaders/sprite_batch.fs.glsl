@@ -0,0 +1,15 @@
+#version 330
+// From vertex shader
+in vec2 texcoord;
+in vec3 tint;
+
+// Application data
+uniform sampler2D sampler0;
+
+// Output color
+layout(location = 0) out  vec4 color;
+
+void main()
+{
+	color = vec4(tint, 1.0) * texture(sampler0, texcoord);
+}
@@ -0,0 +1,29 @@
+#version 330
+// Per vertex: corner of the unit quad, in [-0.5, 0.5]
+layout(location = 0) in vec2 in_corner;
+
+// Per instance: one record per submitted sprite
+layout(location = 1) in vec3 in_transform0;
+layout(location = 2) in vec3 in_transform1;
+layout(location = 3) in vec3 in_transform2;
+layout(location = 4) in vec2 in_size;
+layout(location = 5) in vec2 in_uv_min;
+layout(location = 6) in vec2 in_uv_max;
+layout(location = 7) in vec3 in_tint;
+layout(location = 8) in float in_depth;
+
+// Passed to fragment shader
+out vec2 texcoord;
+out vec3 tint;
+
+// Application data
+uniform mat3 projection;
+
+void main()
+{
+	texcoord = mix(in_uv_min, in_uv_max, in_corner + vec2(0.5));
+	tint = in_tint;
+	mat3 transform = mat3(in_transform0, in_transform1, in_transform2);
+	vec3 pos = projection * transform * vec3(in_corner * in_size, 1.0);
+	gl_Position = vec4(pos.xy, in_depth, 1.0);
+}
@@ -7,6 +7,7 @@
 
 
 #include "projectile.h"
+#include "object_pool.hpp"
 
 class Ice_arrow: public Projectile
 {
@@ -14,12 +15,22 @@ class Ice_arrow: public Projectile
 
 public :
 
+    // Shared by every ice arrow, World hands spent ones back through destroy()
+    static ObjectPool<Ice_arrow>& pool();
+
+    Ice_arrow()
+    {
+    }
+
     Ice_arrow(float radius, float projectileSpeed = 400.f, float damage = 40.f)
     {
         init(radius,projectileSpeed, damage);
     }
     bool init(float radius, float projectileSpeed, float damage);
 
+    // Returns the projectile to the pool
+    void destroy() override;
+
     // Renders the fish
     // projection is the 2D orthographic projection matrix
     void draw(const mat3& projection);
@@ -22,14 +22,19 @@ float Ice_arrow_skill::shoot_ice_arrow(std::vector<Projectile *> &hero_projectil
 {
     float d_angle = shoot_range_angle/(num_arrows-1);
     float start_angle = radius - shoot_range_angle/2.f;
-    for (int i= 0; i<num_arrows; i++)
+    int shot = 0;
+    for (; shot<num_arrows; shot++)
     {
-        float current_angle = start_angle + d_angle * i;
-        Ice_arrow* ice_arrow = new Ice_arrow(current_angle, 400.f, damage);
+        float current_angle = start_angle + d_angle * shot;
+        Ice_arrow* ice_arrow = Ice_arrow::pool().acquire();
+        if (ice_arrow == nullptr)
+            break;
+        ice_arrow->init(current_angle, 400.f, damage);
         ice_arrow->set_position(position);
         hero_projectiles.emplace_back(ice_arrow);
     }
-    return mp_cost;
+    // An exhausted pool cuts the volley short, only the arrows that left are paid for
+    return mp_cost * shot / num_arrows;
 
 }
 
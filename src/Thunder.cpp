@@ -1,6 +1,14 @@
 #include "Thunder.h"
 
 float string_time = 300.f;
+
+ObjectPool<Thunder>& Thunder::pool()
+{
+	// A handful of strikes at most, each one lasts a few seconds
+	static ObjectPool<Thunder> pool(16);
+	return pool;
+}
+
 bool Thunder::init(vec2 position, float m_impactTime, float damage,vec2 m_scale, vec3 color, bool isFireRing)
 {
 	// Load shared texture
@@ -30,15 +38,15 @@ void Thunder::update(float ms)
 {
 	elapsedTime += ms;
 	if (m_isFireRing) {
-		thunderBall.update(elapsedTime);
+		thunderBall.update(ms);
 	} else {
 		if (elapsedTime < string_time)
 		{
-			thunderString.update(elapsedTime);
+			thunderString.update(ms);
 		}
 		else if (elapsedTime < impactTime)
 		{
-			thunderBall.update(elapsedTime);
+			thunderBall.update(ms);
 		}
 	}
 }
@@ -61,8 +69,7 @@ void Thunder::draw(const mat3 &projection)
 
 void Thunder::destroy()
 {
-	thunderString.destroy(true);
-	thunderBall.destroy(true);
+	pool().release(this);
 }
 
 bool Thunder::can_remove()
@@ -3,11 +3,15 @@
 #include "ThunderString.h"
 #include "ThunderBall.h"
 #include "enemies.hpp"
+#include "object_pool.hpp"
 
 class Thunder: public Renderable
 {
 
 public:
+	// Shared by every thunder and fire ring, destroy() hands a thunder back
+	static ObjectPool<Thunder>& pool();
+
 	Thunder()
 	{}
 
@@ -26,6 +30,7 @@ public:
 
 	void draw(const mat3 &projection);
 
+	// Returns the thunder to the pool, its buffers are kept for the next strike
 	void destroy();
 
 	float get_radius();
@@ -36,7 +41,8 @@ public:
 
 	~Thunder()
 	{
-		destroy();
+		thunderString.destroy(true);
+		thunderBall.destroy(true);
 	}
 
 	void set_color(vec3 color);
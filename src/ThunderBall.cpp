@@ -1,4 +1,5 @@
 #include "ThunderBall.h"
+#include "gl_state.hpp"
 #include "algorithm"
 
 bool ThunderBall::init(vec2 position,vec2 scale, vec3 color, bool isFireRing)
@@ -31,43 +32,22 @@ bool ThunderBall::init(vec2 position,vec2 scale, vec3 color, bool isFireRing)
 	float wr = texture.subWidth * 0.5f;
 	float hr = texture.height * 0.5f;
 
-	texVertices[0].position = { -wr, +hr, -0.01f };
-	//vertices[0].texcoord = { 0.f, 1.f };
-	texVertices[1].position = { +wr, +hr, -0.01f };
-	//vertices[1].texcoord = { 1.f, 1.f, };
-	texVertices[2].position = { +wr, -hr, -0.01f };
-	//vertices[2].texcoord = { 1.f, 0.f };
-	texVertices[3].position = { -wr, -hr, -0.01f };
-	//vertices[3].texcoord = { 0.f, 0.f };
-
-	for (int i = 0; i <= texture.totalTiles; i++) {
-		texture_locs.push_back((float)i * texture.subWidth / texture.width);
-	}
-
-	// counterclockwise as it's the default opengl front winding direction
-	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-	// Clearing errors
-	gl_flush_errors();
-
-	// Vertex Buffer creation
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
+	// Both variants share this class, the sheet and its clip depend on which one was asked for
+	texture.build_frames(texture.totalTiles);
+	texture.animations.add("strike", { 0, texture.totalTiles, 1000.f / 24.f, true });
+	texture.animations.add("burn", { 0, texture.totalTiles, 1000.f / 9.6f, true });
 
-	// Index Buffer creation
-	glGenBuffers(1, &mesh.ibo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
-
-	// Vertex Array (Container for Vertex + Index buffer)
-	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors())
+	// The quad is uploaded once, animating only moves the window sampled from the sheet
+	if (!gl_reuse_sprite_quad(mesh, wr, hr, -0.01f))
 		return false;
+	m_animation = AnimationPlayer();
+	m_animation.play(texture.animations.find(isFireRing ? "burn" : "strike"));
+	setTextureLocs(m_animation.get_frame());
 
 	// Loading shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
+	if (!effect.load_from_file(shader_path("animated.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	// Setting initial values, scale is negative to make it face the opposite way
 	// 1.0 would be as big as the original texture
@@ -75,8 +55,6 @@ bool ThunderBall::init(vec2 position,vec2 scale, vec3 color, bool isFireRing)
 	m_rotation = 0;
 	m_position = position;
 	elapsedTime = 0;
-	animation_time = 0.0f;
-	first_time = true;
 	custom_color = color;
 	m_isFireRing = isFireRing;
 
@@ -98,59 +76,23 @@ void ThunderBall::destroy(bool reset)
 	glDeleteBuffers(1, &mesh.vbo);
 	glDeleteBuffers(1, &mesh.ibo);
 
-	glDeleteShader(effect.vertex);
-	glDeleteShader(effect.fragment);
-	glDeleteShader(effect.program);
-
 	if(reset) {
 		glDeleteVertexArrays(1, &mesh.vao);
-		glDetachShader(effect.program, effect.vertex);
-		glDetachShader(effect.program, effect.fragment);
+		effect.release();
+		texture.release();
 	}
 }
 
 void ThunderBall::update(float ms)
 {
 	//animation
-
-	float animation_speed = 0.2f;
-	if (m_isFireRing) {
-		animation_speed = 0.08f;
-	}
-	animation_time += animation_speed * 2;
-	int curidx = 0;
-	curidx += (int)animation_time % texture.totalTiles;
-	setTextureLocs(curidx);
+	m_animation.update(ms);
+	setTextureLocs(m_animation.get_frame());
 }
 
 void ThunderBall::setTextureLocs(int index)
 {
-	texVertices[0].texcoord = { texture_locs[index], 1.f }; //top left
-	texVertices[1].texcoord = { texture_locs[index + 1], 1.f }; //top right
-	texVertices[2].texcoord = { texture_locs[index + 1], 0.f }; //bottom right
-	texVertices[3].texcoord = { texture_locs[index], 0.f }; //bottom left
-
-	// counterclockwise as it's the default opengl front winding direction
-	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-	// Clearing errors
-	gl_flush_errors();
-
-	// Clear memory allocation
-	if (!first_time) {
-		destroy(false);
-	}
-
-	// Vertex Buffer creation
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
-
-	// Index Buffer creation
-	glGenBuffers(1, &mesh.ibo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
-	first_time = false;
+	m_frame = texture.get_frame(index);
 }
 
 vec2 ThunderBall::get_bounding_box()
@@ -172,39 +114,31 @@ void ThunderBall::draw(const mat3 &projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint uv_offset_uloc = effect.locations->uv_offset;
+	GLint uv_scale_uloc = effect.locations->uv_scale;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture.id);
+	GLState::instance().bind_texture(0, texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
 	float color[] = {custom_color.x, custom_color.y, custom_color.z};
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
+	m_frame.set_uniforms(uv_offset_uloc, uv_scale_uloc);
 
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
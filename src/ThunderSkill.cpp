@@ -57,7 +57,10 @@ float ThunderSkill::get_mpcost()
 
 float ThunderSkill::drop_thunder(std::vector<Thunder*> &thunders, vec2 position)
 {
-	Thunder* t = new Thunder(position, impactTime,damage,scale);
+	Thunder* t = Thunder::pool().acquire();
+	if (t == nullptr)
+		return 0.f;
+	t->init(position, impactTime, damage, scale);
 	thunders.emplace_back(t);
 	return mp_cost;
 }
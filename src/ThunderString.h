@@ -34,10 +34,8 @@ protected:
 	float m_rotation; // in radians
 	vec2 velocity;
 	float initial_speed;
-	float animation_time;
-	TexturedVertex texVertices[4];
-	std::vector<float> texture_locs;
-	bool first_time;
+	SpriteFrame m_frame; // part of the sprite sheet currently displayed
+	AnimationPlayer m_animation;
 	vec3 custom_color;
 };
 
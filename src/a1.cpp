@@ -7,8 +7,13 @@
 #include <gl3w.h>
 
 // stlib
+#include <algorithm>
 #include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 using Clock = std::chrono::high_resolution_clock;
 
@@ -18,9 +23,96 @@ const int width = 1280;
 const int height = 720;
 const char* title = "Mystic Crusaders";
 
+// Simulation runs at a fixed rate whatever the display does, see --sim-rate and --max-steps
+const float DEFAULT_SIM_RATE = 120.f;
+const int DEFAULT_MAX_STEPS = 8;
+const int DEFAULT_HEADLESS_FRAMES = 10000;
+
+// Steps a windowless world as fast as it goes and reports what a step costs, for tracking
+// simulation performance on machines without a GPU (--headless). Without a replay the world
+// starts in the first level and runs frames steps, with one it runs the recorded session
+// (or its first frames steps) so builds can be compared on the exact same workload.
+int run_headless(float step_ms, int frames, const char* replay_path)
+{
+	auto init_start = Clock::now();
+	if (!world.init({ (float)width, (float)height }, true))
+		return EXIT_FAILURE;
+
+	if (replay_path != nullptr)
+	{
+		if (!world.start_replay(replay_path, step_ms))
+		{
+			world.destroy();
+			return EXIT_FAILURE;
+		}
+	}
+	else
+		world.startGame();
+
+	std::vector<float> frame_ms;
+	frame_ms.reserve(std::min(frames, 1 << 20));
+	auto start = Clock::now();
+	float init_ms = (float)(std::chrono::duration_cast<std::chrono::microseconds>(start - init_start)).count() / 1000;
+	auto t = start;
+	while ((int)frame_ms.size() < frames && !world.is_over())
+	{
+		world.update(step_ms);
+		auto now = Clock::now();
+		frame_ms.push_back((float)(std::chrono::duration_cast<std::chrono::microseconds>(now - t)).count() / 1000);
+		t = now;
+	}
+	float total_ms = (float)(std::chrono::duration_cast<std::chrono::microseconds>(t - start)).count() / 1000;
+	world.destroy();
+	if (frame_ms.empty())
+		return EXIT_SUCCESS;
+
+	// One line, easy to scrape from CI logs
+	size_t count = frame_ms.size();
+	std::sort(frame_ms.begin(), frame_ms.end());
+	printf("headless: init %.1f ms, %d frames in %.1f ms, %.4f ms/frame, %.0f frames/s, p50 %.4f p99 %.4f max %.4f ms\n",
+		init_ms, (int)count, total_ms, total_ms / count, count * 1000.f / std::max(total_ms, 0.001f),
+		frame_ms[count / 2], frame_ms[count * 99 / 100], frame_ms.back());
+	return EXIT_SUCCESS;
+}
+
 // Entry point
 int main(int argc, char* argv[])
 {
+	float sim_rate = DEFAULT_SIM_RATE;
+	int max_steps = DEFAULT_MAX_STEPS;
+	bool headless = false;
+	bool show_stats = false;
+	int headless_frames = 0;
+	const char* record_path = nullptr;
+	const char* replay_path = nullptr;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+			headless = true;
+		else if (strcmp(argv[i], "--stats") == 0)
+			show_stats = true;
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+			headless_frames = std::max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+			record_path = argv[++i];
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+			replay_path = argv[++i];
+		else if (strcmp(argv[i], "--sim-rate") == 0 && i + 1 < argc)
+			sim_rate = std::max((float)atof(argv[++i]), 1.f);
+		else if (strcmp(argv[i], "--max-steps") == 0 && i + 1 < argc)
+			max_steps = std::max(atoi(argv[++i]), 1);
+		else
+			fprintf(stderr, "Unknown option %s\n", argv[i]);
+	}
+
+	float step_ms = 1000.f / sim_rate;
+	if (headless)
+	{
+		// A replay runs to its end unless told otherwise
+		if (headless_frames == 0)
+			headless_frames = (replay_path != nullptr) ? INT_MAX : DEFAULT_HEADLESS_FRAMES;
+		return run_headless(step_ms, headless_frames, replay_path);
+	}
 
 	if (!world.init({ (float)width, (float)height }))
 	{
@@ -30,9 +122,28 @@ int main(int argc, char* argv[])
 		return EXIT_FAILURE;
 	}
 
+	world.set_show_stats(show_stats);
+
+	// A replay plays over the live input, recording it at the same time makes no sense
+	if (replay_path != nullptr)
+	{
+		if (!world.start_replay(replay_path, step_ms))
+		{
+			world.destroy();
+			return EXIT_FAILURE;
+		}
+	}
+	else if (record_path != nullptr && !world.start_recording(record_path, step_ms))
+	{
+		world.destroy();
+		return EXIT_FAILURE;
+	}
+
+	float accumulator_ms = 0.f;
 	auto t = Clock::now();
 
-	// variable timestep loop.. can be improved (:
+	// Fixed timestep loop: the world always advances by step_ms, rendering blends the last
+	// two steps with whatever time is left over
 	while (!world.is_over())
 	{
 		// Processes system messages, if this wasn't present the window would become unresponsive
@@ -40,14 +151,28 @@ int main(int argc, char* argv[])
 
 		// Calculating elapsed times in milliseconds from the previous iteration
 		auto now = Clock::now();
-		float elapsed_sec = (float)(std::chrono::duration_cast<std::chrono::microseconds>(now - t)).count() / 1000;
+		float elapsed_ms = (float)(std::chrono::duration_cast<std::chrono::microseconds>(now - t)).count() / 1000;
 		t = now;
+		accumulator_ms += elapsed_ms;
+
+		int steps = 0;
+		while (accumulator_ms >= step_ms && steps < max_steps)
+		{
+			world.update(step_ms);
+			accumulator_ms -= step_ms;
+			++steps;
+		}
+
+		// Too far behind (breakpoint, window drag..), drop the backlog instead of spiraling
+		if (steps == max_steps)
+			accumulator_ms = std::min(accumulator_ms, step_ms);
 
-		world.update(elapsed_sec);
-		world.draw();
+		world.draw(accumulator_ms / step_ms);
 	}
-	world.shop.save();
+	// The coins of a replayed session were already earned once
+	if (replay_path == nullptr)
+		world.shop.save();
 	world.destroy();
 
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 // Header
 #include "altar_portal.hpp"
+#include "gl_state.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -24,44 +25,19 @@ bool AltarPortal::init(vec2 screen)
 	float wr = altar_texture.subWidth * 0.5f;
 	float hr = altar_texture.height * 0.5f;
 
-	texVertices[0].position = { -wr, +hr, -0.01f };
-	//vertices[0].texcoord = { 0.f, 1.f };
-	texVertices[1].position = { +wr, +hr, -0.01f };
-	//vertices[1].texcoord = { 1.f, 1.f, };
-	texVertices[2].position = { +wr, -hr, -0.01f };
-	//vertices[2].texcoord = { 1.f, 0.f };
-	texVertices[3].position = { -wr, -hr, -0.01f };
-	//vertices[3].texcoord = { 0.f, 0.f };
-
-	for (int i = 0; i <= altar_texture.totalTiles; i++) {
-		texture_locs.push_back((float)i * altar_texture.subWidth / altar_texture.width);
-	}
-
-	// counterclockwise as it's the default opengl front winding direction
-	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-	// Clearing errors
-	gl_flush_errors();
-
-	// Vertex Buffer creation
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
+	// Frames are shared by every AltarPortal
+	if (altar_texture.frames.empty())
+		altar_texture.build_frames(altar_texture.totalTiles);
 
-	// Index Buffer creation
-	glGenBuffers(1, &mesh.ibo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
-	setTextureLocs(0);
-
-	// Vertex Array (Container for Vertex + Index buffer)
-	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors())
+	// The quad is uploaded once, animating only moves the window sampled from the sheet
+	if (!gl_create_sprite_quad(mesh, wr, hr, -0.01f))
 		return false;
+	setTextureLocs(0);
 
 	// Loading shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
+	if (!effect.load_from_file(shader_path("animated.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	// Setting initial values, scale is negative to make it face the opposite way
 	// 1.0 would be as big as the original texture
@@ -107,9 +83,7 @@ void AltarPortal::destroy()
     glDeleteBuffers(1, &mesh.ibo);
 	glDeleteVertexArrays(1, &mesh.vao);
 
-    glDeleteShader(effect.vertex);
-    glDeleteShader(effect.fragment);
-    glDeleteShader(effect.program);
+    effect.release();
 }
 
 vec2 AltarPortal::get_position()
@@ -136,69 +110,44 @@ void AltarPortal::draw(const mat3& projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint uv_offset_uloc = effect.locations->uv_offset;
+	GLint uv_scale_uloc = effect.locations->uv_scale;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, altar_texture.id);
+	GLState::instance().bind_texture(0, altar_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
 	float color[] = {1.f, 1.f, 1.f};
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
+	m_frame.set_uniforms(uv_offset_uloc, uv_scale_uloc);
 
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
 }
 
-void AltarPortal::setTextureLocs(int index)
+GLuint AltarPortal::get_texture_id()const
 {
-	texVertices[0].texcoord = { texture_locs[index], 1.f }; //top left
-	texVertices[1].texcoord = { texture_locs[index + 1], 1.f }; //top right
-	texVertices[2].texcoord = { texture_locs[index + 1], 0.f }; //bottom right
-	texVertices[3].texcoord = { texture_locs[index], 0.f }; //bottom left
-
-	// counterclockwise as it's the default opengl front winding direction
-	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-	// Clearing errors
-	gl_flush_errors();
-
-	// Clear memory allocation
-	destroy();
-
-	// Vertex Buffer creation
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
+	return altar_texture.id;
+}
 
-	// Index Buffer creation
-	glGenBuffers(1, &mesh.ibo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
+void AltarPortal::setTextureLocs(int index)
+{
+	m_frame = altar_texture.get_frame(index);
 }
 
 
@@ -257,7 +206,10 @@ void AltarPortal::killAll(std::vector<Thunder*> & thunders) {
 	float damage = 400.f;
 	vec2 scale = {16.f, 16.f};
 	vec3 color = {0.8f,0.2f,0.2f};
-	Thunder* t1 = new Thunder({m_screen.x/2, m_screen.y/2}, duration, damage, scale, color, true);
+	Thunder* t1 = Thunder::pool().acquire();
+	if (t1 == nullptr)
+		return;
+	t1->init({m_screen.x/2, m_screen.y/2}, duration, damage, scale, color, true);
 	thunders.emplace_back(t1);
 }
 
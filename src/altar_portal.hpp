@@ -31,6 +31,8 @@ public:
 
     void draw(const mat3& projection)override;
 
+    GLuint get_texture_id()const override;
+
 	bool collides_with(Projectile &projectile);
 	bool collides_with(Hero &hero);
 	bool collides_with(Enemies &enemy);
@@ -50,6 +52,5 @@ private:
 	bool justChangedToPortal;
 	vec2 m_screen;
 	float animation_time;
-	TexturedVertex texVertices[4];
-	std::vector<float> texture_locs;
+	SpriteFrame m_frame; // part of the sprite sheet currently displayed
 };
\ No newline at end of file
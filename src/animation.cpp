@@ -0,0 +1,67 @@
+// Header
+#include "animation.hpp"
+
+void AnimationSet::add(const std::string& name, const AnimationClip& clip)
+{
+	m_clips[name] = clip;
+}
+
+const AnimationClip* AnimationSet::find(const std::string& name)const
+{
+	auto it = m_clips.find(name);
+	if (it == m_clips.end())
+		return nullptr;
+	return &it->second;
+}
+
+bool AnimationSet::empty()const
+{
+	return m_clips.empty();
+}
+
+AnimationPlayer::AnimationPlayer() :
+	m_clip(nullptr),
+	m_time_ms(0.f)
+{
+
+}
+
+void AnimationPlayer::play(const AnimationClip* clip)
+{
+	if (clip == m_clip)
+		return;
+	m_clip = clip;
+	m_time_ms = 0.f;
+}
+
+void AnimationPlayer::update(float ms, float rate)
+{
+	if (m_clip == nullptr)
+		return;
+
+	m_time_ms += ms * rate;
+
+	// Keep the clock bounded so long running loops do not lose float precision
+	float duration = m_clip->frame_ms * m_clip->frame_count;
+	if (m_clip->loop && m_time_ms >= duration)
+		m_time_ms -= duration * (int)(m_time_ms / duration);
+}
+
+int AnimationPlayer::get_frame()const
+{
+	if (m_clip == nullptr)
+		return -1;
+
+	int frame = (int)(m_time_ms / m_clip->frame_ms);
+	if (m_clip->loop)
+		frame %= m_clip->frame_count;
+	else if (frame >= m_clip->frame_count)
+		frame = m_clip->frame_count - 1;
+	return m_clip->first_frame + frame;
+}
+
+bool AnimationPlayer::is_finished()const
+{
+	return m_clip != nullptr && !m_clip->loop &&
+		m_time_ms >= m_clip->frame_ms * m_clip->frame_count;
+}
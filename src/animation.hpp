@@ -0,0 +1,55 @@
+#pragma once
+
+// stlib
+#include <map>
+#include <string>
+
+// A run of consecutive frames of a sprite sheet played at a fixed rate
+struct AnimationClip
+{
+	int first_frame;
+	int frame_count;
+	float frame_ms; // time each frame stays on screen
+	bool loop; // otherwise the last frame is held once the clip is over
+};
+
+// Named clips of a sprite sheet, filled once and shared by every entity drawing that sheet
+class AnimationSet
+{
+public:
+	// Registers clip under name, replacing any clip with the same name
+	void add(const std::string& name, const AnimationClip& clip);
+
+	// Returns nullptr if nothing was registered under name. Pointers stay valid for the
+	// lifetime of the set, so entities look clips up on state changes and keep them.
+	const AnimationClip* find(const std::string& name)const;
+
+	bool empty()const;
+
+private:
+	std::map<std::string, AnimationClip> m_clips;
+};
+
+// Playback state of a single entity: the clip it shows and how long it has been playing it.
+// Time is in ms of game time so the animation speed does not depend on the frame rate.
+class AnimationPlayer
+{
+public:
+	AnimationPlayer();
+
+	// Starts clip from its first frame, does nothing if it is already playing
+	void play(const AnimationClip* clip);
+
+	// Advances playback by ms, rate scales the clip speed (1.f plays it as authored)
+	void update(float ms, float rate = 1.f);
+
+	// Index in the sprite sheet of the frame to display, -1 if no clip is playing
+	int get_frame()const;
+
+	// True once a non looping clip reached its last frame
+	bool is_finished()const;
+
+private:
+	const AnimationClip* m_clip;
+	float m_time_ms;
+};
@@ -1,4 +1,5 @@
 #include "bar_description.hpp"
+#include "gl_state.hpp"
 
 #include "skilltree.hpp"
 
@@ -62,6 +63,7 @@ bool Bar_description::init(vec2 screen)
 	// Loading shaders
 	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 	float x = screen.x;
 	float y = screen.y;
 
@@ -87,33 +89,22 @@ void Bar_description::draw(const mat3 & projection)
 	transform_scale(m_scale);
 	transform_end();
 
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, hme_texture.id);
+	GLState::instance().bind_texture(0, hme_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
@@ -33,6 +33,8 @@ public:
 
 	void draw(const mat3& projection)override;
 
+	GLuint get_texture_id()const override;
+
 	// Returns the current salmon position
 	vec2 get_position()const;
 
@@ -64,10 +66,8 @@ private:
 	//spritesheet
 	clock_t timePassed;
 	float variation;
-	TexturedVertex texVertices[4];
-	std::vector<float> texture_locs;
-	float m_animTime = 0.0f;
-	int numTiles;
+	SpriteFrame m_frame; // part of the sprite sheet currently displayed
+	AnimationPlayer m_animation;
 	bool m_is_alive;
 	float damage;
 
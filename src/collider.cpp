@@ -0,0 +1,233 @@
+// Header
+#include "collider.hpp"
+
+// stlib
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+	vec2 sub(vec2 a, vec2 b)
+	{
+		return { a.x - b.x, a.y - b.y };
+	}
+
+	vec2 unit(vec2 v)
+	{
+		float length = std::sqrt(v.x * v.x + v.y * v.y);
+		if (length == 0.f)
+			return { 1.f, 0.f };
+		return { v.x / length, v.y / length };
+	}
+
+	// Polygon view of a box or hull, boxes are expanded into corners on the stack
+	struct Polygon
+	{
+		vec2 corners[4];
+		const vec2* points;
+		size_t count;
+	};
+
+	void as_polygon(const Collider& c, Polygon& out)
+	{
+		if (c.shape == Collider::HULL)
+		{
+			out.points = c.points;
+			out.count = c.count;
+			return;
+		}
+
+		vec2 x = { c.axes[0].x * c.half_extents.x, c.axes[0].y * c.half_extents.x };
+		vec2 y = { c.axes[1].x * c.half_extents.y, c.axes[1].y * c.half_extents.y };
+		out.corners[0] = { c.center.x - x.x - y.x, c.center.y - x.y - y.y };
+		out.corners[1] = { c.center.x + x.x - y.x, c.center.y + x.y - y.y };
+		out.corners[2] = { c.center.x + x.x + y.x, c.center.y + x.y + y.y };
+		out.corners[3] = { c.center.x - x.x + y.x, c.center.y - x.y + y.y };
+		out.points = out.corners;
+		out.count = 4;
+	}
+
+	void project(const Polygon& polygon, vec2 axis, float& min, float& max)
+	{
+		min = max = dot(polygon.points[0], axis);
+		for (size_t i = 1; i < polygon.count; ++i)
+		{
+			float d = dot(polygon.points[i], axis);
+			min = std::min(min, d);
+			max = std::max(max, d);
+		}
+	}
+
+	bool separated_on(const Polygon& a, const Polygon& b, vec2 axis)
+	{
+		float min_a, max_a, min_b, max_b;
+		project(a, axis, min_a, max_a);
+		project(b, axis, min_b, max_b);
+		return max_a < min_b || max_b < min_a;
+	}
+
+	// Separating axes of a box are its two local axes, a hull has one per edge
+	bool separated_by_edges_of(const Collider& c, const Polygon& self, const Polygon& other)
+	{
+		if (c.shape == Collider::BOX)
+			return separated_on(self, other, c.axes[0]) || separated_on(self, other, c.axes[1]);
+
+		for (size_t i = 0; i < self.count; ++i)
+		{
+			vec2 edge = sub(self.points[(i + 1) % self.count], self.points[i]);
+			if (separated_on(self, other, { -edge.y, edge.x }))
+				return true;
+		}
+		return false;
+	}
+
+	bool polygon_polygon(const Collider& a, const Collider& b)
+	{
+		Polygon pa, pb;
+		as_polygon(a, pa);
+		as_polygon(b, pb);
+		return !separated_by_edges_of(a, pa, pb) && !separated_by_edges_of(b, pb, pa);
+	}
+
+	bool circle_box(const Collider& circle, const Collider& box)
+	{
+		// Closest point of the box in its own frame
+		vec2 d = sub(circle.center, box.center);
+		float local_x = dot(d, box.axes[0]);
+		float local_y = dot(d, box.axes[1]);
+		float dx = local_x - std::max(-box.half_extents.x, std::min(local_x, box.half_extents.x));
+		float dy = local_y - std::max(-box.half_extents.y, std::min(local_y, box.half_extents.y));
+		return dx * dx + dy * dy <= circle.radius * circle.radius;
+	}
+
+	bool circle_hull(const Collider& circle, const Collider& hull)
+	{
+		bool inside = true;
+		float r_sq = circle.radius * circle.radius;
+		for (size_t i = 0; i < hull.count; ++i)
+		{
+			vec2 a = hull.points[i];
+			vec2 edge = sub(hull.points[(i + 1) % hull.count], a);
+			vec2 to_center = sub(circle.center, a);
+			if (det(edge, to_center) < 0.f)
+				inside = false;
+
+			// Closest point on the edge
+			float length_sq = dot(edge, edge);
+			float t = length_sq > 0.f ? std::max(0.f, std::min(1.f, dot(to_center, edge) / length_sq)) : 0.f;
+			vec2 closest = { a.x + edge.x * t, a.y + edge.y * t };
+			vec2 d = sub(circle.center, closest);
+			if (dot(d, d) <= r_sq)
+				return true;
+		}
+		return inside;
+	}
+}
+
+Collider Collider::circle(vec2 center, float radius)
+{
+	Collider c;
+	c.shape = CIRCLE;
+	c.center = center;
+	c.radius = radius;
+	c.axes[0] = { 1.f, 0.f };
+	c.axes[1] = { 0.f, 1.f };
+	c.half_extents = { radius, radius };
+	c.points = nullptr;
+	c.count = 0;
+	return c;
+}
+
+Collider Collider::box(vec2 center, vec2 half_extents, vec2 x_axis)
+{
+	Collider c;
+	c.shape = BOX;
+	c.center = center;
+	c.radius = std::sqrt(half_extents.x * half_extents.x + half_extents.y * half_extents.y);
+	c.axes[0] = unit(x_axis);
+	c.axes[1] = { -c.axes[0].y, c.axes[0].x };
+	c.half_extents = half_extents;
+	c.points = nullptr;
+	c.count = 0;
+	return c;
+}
+
+Collider Collider::hull(const vec2* points, size_t count)
+{
+	Collider c;
+	c.shape = HULL;
+	c.center = { 0.f, 0.f };
+	c.radius = 0.f;
+	c.axes[0] = { 1.f, 0.f };
+	c.axes[1] = { 0.f, 1.f };
+	c.half_extents = { 0.f, 0.f };
+	c.points = points;
+	c.count = count;
+
+	// Bounding circle around the vertex average
+	for (size_t i = 0; i < count; ++i)
+	{
+		c.center.x += points[i].x / count;
+		c.center.y += points[i].y / count;
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		vec2 d = sub(points[i], c.center);
+		c.radius = std::max(c.radius, dot(d, d));
+	}
+	c.radius = std::sqrt(c.radius);
+	return c;
+}
+
+bool collides(const Collider& a, const Collider& b)
+{
+	// Bounding circles first, that's all there is to test for two circles
+	vec2 d = sub(a.center, b.center);
+	float r = a.radius + b.radius;
+	if (dot(d, d) > r * r)
+		return false;
+
+	if (a.shape == Collider::CIRCLE && b.shape == Collider::CIRCLE)
+		return true;
+	if (a.shape == Collider::CIRCLE)
+		return b.shape == Collider::BOX ? circle_box(a, b) : circle_hull(a, b);
+	if (b.shape == Collider::CIRCLE)
+		return a.shape == Collider::BOX ? circle_box(b, a) : circle_hull(b, a);
+	if ((a.shape == Collider::HULL && a.count == 0) || (b.shape == Collider::HULL && b.count == 0))
+		return false;
+	return polygon_polygon(a, b);
+}
+
+void convex_hull(std::vector<vec2> points, std::vector<vec2>& out)
+{
+	// Andrew's monotone chain
+	out.clear();
+	std::sort(points.begin(), points.end(), [](vec2 a, vec2 b) {
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	});
+	points.erase(std::unique(points.begin(), points.end(), [](vec2 a, vec2 b) {
+		return a.x == b.x && a.y == b.y;
+	}), points.end());
+	if (points.size() < 3)
+	{
+		out = points;
+		return;
+	}
+
+	out.resize(2 * points.size());
+	size_t k = 0;
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		while (k >= 2 && det(sub(out[k - 1], out[k - 2]), sub(points[i], out[k - 2])) <= 0.f)
+			--k;
+		out[k++] = points[i];
+	}
+	for (size_t i = points.size() - 1, lower = k + 1; i > 0; --i)
+	{
+		while (k >= lower && det(sub(out[k - 1], out[k - 2]), sub(points[i - 1], out[k - 2])) <= 0.f)
+			--k;
+		out[k++] = points[i - 1];
+	}
+	out.resize(k - 1);
+}
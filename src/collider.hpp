@@ -0,0 +1,43 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// Analytic collision shape in world space. Circles are tested by closest point, boxes and
+// hulls by separating axes, so thin or fast objects can't slip between sample points.
+// Colliders are cheap values meant to be built right before a test, except hulls which
+// only reference vertices owned by the entity.
+struct Collider
+{
+	enum Shape : uint8_t
+	{
+		CIRCLE,
+		BOX,
+		HULL
+	};
+
+	Shape shape;
+	vec2 center;
+	float radius; // exact for circles, bounding radius of boxes and hulls
+	vec2 axes[2]; // boxes: unit local x and y axes
+	vec2 half_extents; // boxes: half size along each axis
+	const vec2* points; // hulls: counterclockwise convex polygon, not owned
+	size_t count;
+
+	static Collider circle(vec2 center, float radius);
+
+	// Box of the given half extents turned so its local x axis points along x_axis, which
+	// does not need to be normalized (usually the first column of the entity transform)
+	static Collider box(vec2 center, vec2 half_extents, vec2 x_axis);
+
+	// points have to outlive the collider
+	static Collider hull(const vec2* points, size_t count);
+};
+
+bool collides(const Collider& a, const Collider& b);
+
+// Convex hull of points in counterclockwise order, collinear points dropped
+void convex_hull(std::vector<vec2> points, std::vector<vec2>& out);
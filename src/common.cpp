@@ -1,9 +1,12 @@
 #include "common.hpp"
-
-#define STB_IMAGE_IMPLEMENTATION
-#include "../ext/stb_image/stb_image.h"
+#include "gl_state.hpp"
+#include "shader_registry.hpp"
+#include "texture_cache.hpp"
+#include "font_atlas.hpp"
 
 // stlib
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
@@ -99,34 +102,55 @@ float det(vec2 u, vec2 v)
 	return u.x * v.y - u.y * v.x;
 }
 
-Texture::Texture()
+void PreviousPosition::save(vec2 current)
+{
+	position = current;
+	valid = true;
+}
+
+void PreviousPosition::reset()
+{
+	valid = false;
+}
+
+vec2 PreviousPosition::blend(vec2 current, float alpha)const
+{
+	if (!valid)
+		return current;
+	return { position.x + (current.x - position.x) * alpha, position.y + (current.y - position.y) * alpha };
+}
+
+Texture::Texture() :
+	id(0),
+	depth_render_buffer_id(0),
+	width(0),
+	height(0),
+	cached(false)
 {
 
 }
 
 Texture::~Texture()
 {
-	if (id != 0) glDeleteTextures(1, &id);
+	// Cached images outlive their handles, the TextureCache deletes them
+	if (id != 0 && !cached) glDeleteTextures(1, &id);
 	if (depth_render_buffer_id != 0) glDeleteRenderbuffers(1, &depth_render_buffer_id);
 }
 
 bool Texture::load_from_file(const char* path)
 {
-	if (path == nullptr) 
-		return false;
-	
-	stbi_uc* data = stbi_load(path, &width, &height, NULL, 4);
-	if (data == NULL)
+	// Acquire before releasing so reloading the same file never drops it from the cache
+	Texture previous = *this;
+	previous.depth_render_buffer_id = 0;
+	if (!TextureCache::instance().acquire(path, *this))
 		return false;
+	previous.release();
+	return true;
+}
 
-	gl_flush_errors();
-	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_2D, id);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	stbi_image_free(data);
-	return !gl_has_errors();
+void Texture::release()
+{
+	TextureCache::instance().release(*this);
 }
 
 // http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-14-render-to-texture/
@@ -165,263 +189,216 @@ bool Texture::is_valid()const
 	return id != 0;
 }
 
-namespace
+Mesh::Mesh() :
+	vao(0),
+	vbo(0),
+	ibo(0)
 {
-	bool gl_compile_shader(GLuint shader)
-	{
-		glCompileShader(shader);
-		GLint success = 0;
-		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-		if (success == GL_FALSE)
-		{
-			GLint log_len;
-			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_len);
-			std::vector<char> log(log_len);
-			glGetShaderInfoLog(shader, log_len, &log_len, log.data());
-			glDeleteShader(shader);
-
-			fprintf(stderr, "GLSL: %s", log.data());
-			return false;
-		}
 
-		return true;
-	}
 }
 
-bool Effect::load_from_file(const char* vs_path, const char* fs_path)
+ShaderLocations::ShaderLocations() :
+	transform(-1),
+	projection(-1),
+	fcolor(-1),
+	light_up(-1),
+	time(-1),
+	uv_offset(-1),
+	uv_scale(-1),
+	in_position(-1),
+	in_texcoord(-1),
+	in_color(-1)
 {
-	gl_flush_errors();
 
-	// Opening files
-	std::ifstream vs_is(vs_path);
-	std::ifstream fs_is(fs_path);
+}
 
-	if (!vs_is.good() || !fs_is.good())
-	{
-		fprintf(stderr, "Failed to load shader files %s, %s", vs_path, fs_path);
-		return false;
-	}
+GLint ShaderLocations::get_uniform(const char* name)const
+{
+	auto it = uniforms.find(name);
+	return it != uniforms.end() ? it->second : -1;
+}
 
-	// Reading sources
-	std::stringstream vs_ss, fs_ss;
-	vs_ss << vs_is.rdbuf();
-	fs_ss << fs_is.rdbuf();
-	std::string vs_str = vs_ss.str();
-	std::string fs_str = fs_ss.str();
-	const char* vs_src = vs_str.c_str();
-	const char* fs_src = fs_str.c_str();
-	GLsizei vs_len = (GLsizei)vs_str.size();
-	GLsizei fs_len = (GLsizei)fs_str.size();
-
-	vertex = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertex, 1, &vs_src, &vs_len);
-	fragment = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragment, 1, &fs_src, &fs_len);
-
-	// Compiling
-	// Shaders already delete if compilation fails
-	if (!gl_compile_shader(vertex))
-		return false;
+GLint ShaderLocations::get_attribute(const char* name)const
+{
+	auto it = attributes.find(name);
+	return it != attributes.end() ? it->second : -1;
+}
 
-	if (!gl_compile_shader(fragment))
-	{
-		glDeleteShader(vertex);
-		return false;
-	}
+Effect::Effect() :
+	vertex(0),
+	fragment(0),
+	program(0),
+	locations(nullptr)
+{
+
+}
+
+bool Effect::load_from_file(const char* vs_path, const char* fs_path)
+{
+	// Re-initializing an entity must not leak the reference it already holds
+	release();
+	return ShaderRegistry::instance().acquire(vs_path, fs_path, *this);
+}
+
+void Effect::release()
+{
+	ShaderRegistry::instance().release(*this);
+}
 
-	// Linking
-	program = glCreateProgram();
-	glAttachShader(program, vertex);
-	glAttachShader(program, fragment);
-	glLinkProgram(program);
+namespace
+{
+	void gl_capture_layout(const Mesh& mesh, GLint position_loc, GLint second_loc, GLint second_size, GLsizei stride)
 	{
-		GLint is_linked = 0;
-		glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
-		if (is_linked == GL_FALSE)
+		glBindVertexArray(mesh.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+		if (position_loc >= 0)
 		{
-			GLint log_len;
-			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_len);
-			std::vector<char> log(log_len);
-			glGetProgramInfoLog(program, log_len, &log_len, log.data());
-
-			release();
-			fprintf(stderr, "Link error: %s", log.data());
-			return false;
+			glEnableVertexAttribArray(position_loc);
+			glVertexAttribPointer(position_loc, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
 		}
+		if (second_loc >= 0)
+		{
+			glEnableVertexAttribArray(second_loc);
+			glVertexAttribPointer(second_loc, second_size, GL_FLOAT, GL_FALSE, stride, (void*)sizeof(vec3));
+		}
+		glBindVertexArray(0);
 	}
-
-	if (gl_has_errors())
-	{
-		release();
-		fprintf(stderr, "OpenGL errors occured while compiling Effect");
-		return false;
-	}
-
-	return true;
 }
 
-void Effect::release()
+void gl_capture_textured_layout(const Mesh& mesh, const Effect& effect)
 {
-//	glDeleteProgram(program);
-//	glDeleteShader(vertex);
-//	glDeleteShader(fragment);
+	gl_capture_layout(mesh, effect.locations->in_position, effect.locations->in_texcoord, 2, sizeof(TexturedVertex));
+}
 
-	glDetachShader(program, vertex);
-	glDeleteShader(vertex);
-	//
-	glDetachShader(program, fragment);
-	glDeleteShader(fragment);
-	//
-	glDeleteProgram(program);
+void gl_capture_colored_layout(const Mesh& mesh, const Effect& effect)
+{
+	gl_capture_layout(mesh, effect.locations->in_position, effect.locations->in_color, 3, sizeof(Vertex));
 }
 
-Text::Text()
+Text::Text() :
+    vao(0),
+    vbo(0),
+    font(nullptr),
+    capacity(0),
+    text_uloc(-1),
+    color_uloc(-1)
 {
 
 }
 
-Text::~Text()
+void Text::release()
 {
-    // glDeleteVertexArrays(1, &vao);
+    glDeleteVertexArrays(1, &vao);
     glDeleteBuffers(1, &vbo);
+    vao = 0;
+    vbo = 0;
+    capacity = 0;
+    font = nullptr;
+    vertices.clear();
     textEffect.release();
 }
 
 bool Text::loadCharacters(const char* ft_path)
 {
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_BLEND); 
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
-
     // Loading shaders
     if (!textEffect.load_from_file(shader_path("text.vs.glsl"), shader_path("text.fs.glsl")))
         return false;
 
-    if (FT_Init_FreeType(&ft)) {
-        std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+    // Every Text using the same font shares the atlas
+    font = FontCache::instance().get(ft_path, 48);
+    if (font == nullptr)
         return false;
-    }
 
-    if (FT_New_Face(ft, ft_path, 0, &face)) {
-        std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
-        return false;
-    }
-
-    FT_Set_Pixel_Sizes(face, 0, 48);
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
-
-    for (GLubyte c = 0; c < 128; c++)
-    {
-        // Load character glyph 
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-        {
-            std::cout << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
-            return false;
-        }
-        // Generate texture
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-        // Set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        // Now store character for later use
-        Character character = {
-            texture,
-            {face->glyph->bitmap.width, face->glyph->bitmap.rows},
-            {face->glyph->bitmap_left, face->glyph->bitmap_top},
-            face->glyph->advance.x
-        };
-        Characters.insert(std::pair<GLchar, Character>(c, character));
-    }
-    glBindTexture(GL_TEXTURE_2D, 0);
-    // clear face and freetype library
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
-
-    // allocate memory
+    // allocate memory, grown by RenderText when a longer string comes along
+    capacity = 6 * 32;
     glGenVertexArrays(1, &vao);
     glGenBuffers(1, &vbo);
     glBindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 6, NULL, GL_DYNAMIC_DRAW);
-    GLint in_position_loc = glGetAttribLocation(textEffect.program, "in_position");
-    GLint in_texcoord_loc = glGetAttribLocation(textEffect.program, "in_texcoords");
+    glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * capacity, NULL, GL_DYNAMIC_DRAW);
+    GLint in_position_loc = textEffect.locations->in_position;
+    GLint in_texcoord_loc = textEffect.locations->get_attribute("in_texcoords");
     glEnableVertexAttribArray(in_position_loc);
     glEnableVertexAttribArray(in_texcoord_loc);
     glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
     glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+    vertices.reserve(capacity);
 
-    glDisable(GL_CULL_FACE);
+    text_uloc = textEffect.locations->get_uniform("text");
+    color_uloc = textEffect.locations->get_uniform("textColor");
     return true;
 }
 
 void Text::RenderText(const mat3& projection, std::string text, GLfloat x, GLfloat y, GLfloat scale, vec3 colors)
-{   
-    // Setting uniform values to the currently bound program
-    glUseProgram(textEffect.program);
-    glUniformMatrix3fv(glGetUniformLocation(textEffect.program, "projection"), 1, GL_FALSE, (float*)&projection);
-    glUniform1i(glGetUniformLocation(textEffect.program, "text"), 0);
-    glUniform3f(glGetUniformLocation(textEffect.program, "textColor"), colors.x, colors.y, colors.z);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(vao);
+{
+    if (font == nullptr || text.empty())
+        return;
 
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++)
+    // Lay the whole string out first, two triangles per glyph
+    vertices.clear();
+    for (char c : text)
     {
-        Character ch = Characters[*c];
-
-        GLfloat xpos = x + ch.Bearing.x * scale;
-        GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-        GLfloat w = ch.Size.x * scale;
-        GLfloat h = ch.Size.y * scale;
-
-        // Update VBO for each character
-        TexturedVertex vertices[6];
-        vertices[0].position = { xpos, ypos, 1.f };
-        vertices[0].texcoord = { 0.f, 0.f };
-        vertices[1].position = { xpos, ypos+h, 1.f };
-        vertices[1].texcoord = { 0.f, 1.f };
-        vertices[2].position = { xpos+w, ypos+h, 1.f };
-        vertices[2].texcoord = { 1.f, 1.f };
-        vertices[3].position = { xpos, ypos, 1.f };
-        vertices[3].texcoord = { 0.f, 0.f };
-        vertices[4].position = { xpos+w, ypos+h, 1.f };
-        vertices[4].texcoord = { 1.f, 1.f };
-        vertices[5].position = { xpos+w, ypos, 1.f };
-        vertices[5].texcoord = { 1.f, 0.f };
-        
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.textureID);
-        // Update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // Render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-        x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
+        const Glyph& ch = font->get_glyph(c);
+
+        GLfloat xpos = x + ch.bearing.x * scale;
+        GLfloat ypos = y - (ch.size.y - ch.bearing.y) * scale;
+
+        GLfloat w = ch.size.x * scale;
+        GLfloat h = ch.size.y * scale;
+
+        // Now advance cursors for next glyph
+        x += ch.advance * scale;
+        if (w == 0.f || h == 0.f)
+            continue;
+
+        TexturedVertex quad[6];
+        quad[0].position = { xpos, ypos, 1.f };
+        quad[0].texcoord = { ch.uv_min.x, ch.uv_min.y };
+        quad[1].position = { xpos, ypos+h, 1.f };
+        quad[1].texcoord = { ch.uv_min.x, ch.uv_max.y };
+        quad[2].position = { xpos+w, ypos+h, 1.f };
+        quad[2].texcoord = { ch.uv_max.x, ch.uv_max.y };
+        quad[3].position = { xpos, ypos, 1.f };
+        quad[3].texcoord = { ch.uv_min.x, ch.uv_min.y };
+        quad[4].position = { xpos+w, ypos+h, 1.f };
+        quad[4].texcoord = { ch.uv_max.x, ch.uv_max.y };
+        quad[5].position = { xpos+w, ypos, 1.f };
+        quad[5].texcoord = { ch.uv_max.x, ch.uv_min.y };
+        vertices.insert(vertices.end(), quad, quad + 6);
     }
-	glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (vertices.empty())
+        return;
+
+    // Enabling alpha channel for the glyph coverage
+    GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::instance().set_depth_test(false);
+
+    // Setting uniform values to the currently bound program
+    GLState::instance().use_program(textEffect.program);
+    glUniformMatrix3fv(textEffect.locations->projection, 1, GL_FALSE, (float*)&projection);
+    glUniform1i(text_uloc, 0);
+    glUniform3f(color_uloc, colors.x, colors.y, colors.z);
+    GLState::instance().bind_texture(0, font->texture);
+    GLState::instance().bind_vertex_array(vao);
+
+    // Orphan the previous storage, growing it if the string does not fit
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (vertices.size() > capacity)
+        capacity = std::max(vertices.size(), capacity * 2);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * capacity, NULL, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(TexturedVertex) * vertices.size(), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.size());
+}
+
+GLuint Renderable::get_texture_id()const
+{
+	return 0;
 }
 
 void Renderable::transform_begin()
@@ -494,10 +471,7 @@ bool Renderable::mesh_collision(vec3 ptest, std::vector<vec3> &cur_vertices)
 		float v = (dot00 * dot12 - dot01 * dot02) * invDenom;
 
 		if ((u >= 0) && (v >= 0) && (u + v < 1))
-			int a = 0;
-
-		return (u >= 0) && (v >= 0) && (u + v < 1);
-
+			return true;
 	}
 
 	return false;
@@ -57,6 +57,27 @@ vec2  normalize(vec2 v);
 //creative part
 float det(vec2 u, vec2 v);
 
+// Frame time the per-update terms (momentum, mana regeneration) were tuned for, back when
+// the world updated once per vsynced frame. Scaling them by ms / REFERENCE_FRAME_MS keeps
+// them the same per second at any simulation rate.
+const float REFERENCE_FRAME_MS = 1000.f / 60.f;
+
+// Position an entity had before the last fixed simulation step. World saves it ahead of
+// every step and draws the entity blended between it and the current position.
+struct PreviousPosition
+{
+	vec2 position = { 0.f, 0.f };
+	bool valid = false; // false until the first save, so spawns draw where they are
+
+	void save(vec2 current);
+
+	// Forgets the saved position, for entities starting a new life (pools, restarts)
+	void reset();
+
+	// current when nothing was saved yet, alpha = 0 is the previous step, 1 the current one
+	vec2 blend(vec2 current, float alpha)const;
+};
+
 // OpenGL utilities
 // cleans error buffer
 void gl_flush_errors();
@@ -77,6 +98,9 @@ struct TexturedVertex
 };
 
 // Texture wrapper
+// Images loaded from file are owned by the TextureCache, the Texture is only a handle so
+// re-initializing an entity never decodes the same file twice. Copies share the reference
+// of the handle they were copied from.
 struct Texture
 {
 	Texture();
@@ -86,9 +110,12 @@ struct Texture
 	GLuint depth_render_buffer_id;
 	int width;
 	int height;
+	bool cached; // id belongs to the TextureCache rather than to this texture
 	
 	// Loads texture from file specified by path
 	bool load_from_file(const char* path);
+	// Gives the cached image back, the texture is invalid afterwards
+	void release();
 	// Screen texture
 	bool create_from_screen(GLFWwindow const * const window);
 	bool is_valid()const; // True if texture is valid
@@ -99,52 +126,97 @@ struct Texture
 // an Index Buffer
 struct Mesh
 {
+	Mesh();
 	GLuint vao;
 	GLuint vbo;
 	GLuint ibo;
 };
 
+// Uniform and attribute locations of a linked program, reflected once by the ShaderRegistry
+// so draws never query the driver by name.
+struct ShaderLocations
+{
+	ShaderLocations();
+
+	// Inputs shared by most game shaders, -1 when the program does not declare them
+	GLint transform;
+	GLint projection;
+	GLint fcolor;
+	GLint light_up;
+	GLint time;
+	GLint uv_offset;
+	GLint uv_scale;
+	GLint in_position;
+	GLint in_texcoord;
+	GLint in_color;
+
+	// Every active input by name, for the shader specific ones. Meant for init() code.
+	GLint get_uniform(const char* name)const;
+	GLint get_attribute(const char* name)const;
+
+	std::map<std::string, GLint> uniforms;
+	std::map<std::string, GLint> attributes;
+};
+
 // Container for Vertex and Fragment shader, which are then put(linked) together in a
 // single program that is then bound to the pipeline.
+// Programs are owned by the ShaderRegistry, an Effect is only a reference counted handle
+// so spawning an entity does not recompile anything.
 struct Effect
 {
+	Effect();
+
 	bool load_from_file(const char* vs_path, const char* fs_path);
 	void release();
 
 	GLuint vertex;
 	GLuint fragment;
 	GLuint program;
+	const ShaderLocations* locations; // owned by the ShaderRegistry, null until loaded
 };
 
-// Character wrapper
-struct Character
-{
-    GLuint textureID;  // ID handle of the glyph texture
-    vec2 Size;       // Size of glyph
-    vec2 Bearing;    // Offset from baseline to left/top of glyph
-    GLuint Advance;    // Offset to advance to next glyph
-};
+// Records the attribute layout of mesh's buffers in its VAO, so drawing only has to bind
+// the VAO. Expects TexturedVertex (in_position, in_texcoord) or Vertex (in_position,
+// in_color) buffers respectively.
+void gl_capture_textured_layout(const Mesh& mesh, const Effect& effect);
+void gl_capture_colored_layout(const Mesh& mesh, const Effect& effect);
+
+struct FontAtlas;
 
+// Draws strings with a font atlas shared through the FontCache. A string is laid out into a
+// single vertex buffer and rendered with one draw call.
 struct Text
 {
     GLuint vao, vbo;
     Effect textEffect;
-    std::map<GLchar, Character> Characters;
-
-    FT_Library ft;
-    FT_Face face;
+    const FontAtlas* font;
+    std::vector<TexturedVertex> vertices; // scratch space reused by every RenderText
+    size_t capacity; // number of vertices the vbo can hold
+    GLint text_uloc, color_uloc;
 
     Text();
-    ~Text();
 
     bool loadCharacters(const char* ft_path);
+
+    // Frees the buffers and drops the shader reference. Not done on destruction: Texts live in
+    // the global World, which outlives the ShaderRegistry.
+    void release();
     void RenderText(const mat3& projection, std::string text, GLfloat x, GLfloat y, GLfloat scale, vec3 colors);
 };
 
 // Helper container for all the information we need when rendering an object together
 // with its transform.
+// Renderables are move-only: a copy would duplicate the vertex data and alias the GL
+// handles of the original, so containers have to construct them in place or move them.
 struct Renderable
 {
+	Renderable() = default;
+	Renderable(const Renderable&) = delete;
+	Renderable& operator=(const Renderable&) = delete;
+	Renderable(Renderable&&) = default;
+	Renderable& operator=(Renderable&&) = default;
+	virtual ~Renderable() = default;
+
 	Mesh mesh;
 	Effect effect;
 	mat3 transform;
@@ -157,6 +229,10 @@ struct Renderable
 	// renders itself it needs it to correctly bind it to its shader.
 	virtual void draw(const mat3& projection) = 0;
 
+	// Texture sampled by draw(), used to group draws in the RenderQueue. 0 when the
+	// renderable is untextured or draws through the SpriteBatch.
+	virtual GLuint get_texture_id()const;
+
 	void transform_current_vertex(std::vector<vec3> &cur_vertices);
 
 	bool mesh_collision(vec3 ptest, std::vector<vec3> &cur_vertices);
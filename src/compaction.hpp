@@ -0,0 +1,46 @@
+#pragma once
+
+// stlib
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Frame-level removal for entity lists. Gameplay code only marks entities as dead while it
+// iterates, World then compacts each list once at the end of the tick with one of these,
+// instead of erasing from the middle of the vector and shifting the whole tail every time.
+// is_dead is called exactly once per element, so it may also release what it reports dead.
+
+// Unordered removal, every dead element is overwritten by the current last one
+template <typename T, typename Pred>
+size_t swap_and_pop_if(std::vector<T>& list, Pred is_dead)
+{
+	size_t i = 0;
+	size_t end = list.size();
+	while (i < end)
+	{
+		if (!is_dead(list[i]))
+		{
+			++i;
+			continue;
+		}
+
+		// The element moved in has not been tested yet, stay on i
+		--end;
+		if (i != end)
+			list[i] = std::move(list[end]);
+	}
+
+	size_t removed = list.size() - end;
+	list.erase(list.begin() + end, list.end());
+	return removed;
+}
+
+// Stable removal, survivors keep their relative order
+template <typename T, typename Pred>
+size_t compact_if(std::vector<T>& list, Pred is_dead)
+{
+	auto end = std::remove_if(list.begin(), list.end(), is_dead);
+	size_t removed = list.end() - end;
+	list.erase(end, list.end());
+	return removed;
+}
@@ -32,11 +32,11 @@ vec2 Enemies::get_bounding_box()const
 	return { std::fabs(m_scale.x) * enemy_texture.width, std::fabs(m_scale.y) * enemy_texture.height };
 }
 
-void Enemies::setRandMovementTime(clock_t c){
+void Enemies::setRandMovementTime(double c){
 	randMovementTime = c;
 }
 
-bool Enemies::checkIfCanChangeDirectionOfMove(clock_t currentClock){
+bool Enemies::checkIfCanChangeDirectionOfMove(double currentClock){
 	if ((double)(currentClock - randMovementTime) > randMovementCooldown) {
 		return true;
 	}
@@ -119,7 +119,7 @@ void Enemies::set_stunded(bool hit)
 
 void Enemies::set_wave()
 {
-	waveTime = clock();
+	waveTime = GameClock::instance().now();
 	wave.custom_color = enemyColor;
 	waved = true;
 }
@@ -127,4 +127,16 @@ void Enemies::set_wave()
 void Enemies::set_dangerPos(vec2 pos)
 {
 	dangerPos = pos;
+}
+
+void Enemies::set_path_direction(vec2 direction)
+{
+	path_direction = direction;
+}
+
+float Enemies::get_approach_angle(float away_angle)const
+{
+	if (path_direction.x == 0.f && path_direction.y == 0.f)
+		return away_angle;
+	return atan2(-path_direction.y, -path_direction.x);
 }
\ No newline at end of file
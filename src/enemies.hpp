@@ -2,7 +2,7 @@
 class Thunder;
 #include "common.hpp"
 #include "sprite_sheet.hpp"
-#include "time.h"
+#include "game_clock.hpp"
 #include "projectile.h"
 #include "enemyPowerupWave.h"
 
@@ -46,9 +46,9 @@ public:
 
     void set_rotation(float rotation_value);
 
-    void setRandMovementTime(clock_t c);
+    void setRandMovementTime(double c);
 
-	bool checkIfCanChangeDirectionOfMove(clock_t currentClock);
+	bool checkIfCanChangeDirectionOfMove(double currentClock);
 
 	vec2 get_momentum();
 
@@ -62,12 +62,20 @@ public:
 
     void set_wave();
 
-    clock_t waveTime;
+    double waveTime;
 
     bool waved;
 
     void set_dangerPos(vec2 pos);
 
+	// Direction to travel in to reach the hero around the obstacles, handed out by World's
+	// FlowField before every update. Zero when the straight line has to do.
+	void set_path_direction(vec2 direction);
+
+	// Angle to move along with a negative step (like enemy_angle) to approach the hero:
+	// the path direction when there is one, away_angle otherwise
+	float get_approach_angle(float away_angle)const;
+
 protected:
 	EnemyPowerupWave wave;
 
@@ -80,7 +88,7 @@ public:
     float hp;
     bool m_is_alive; // True if the enemy is alive
     float randMovementCooldown;
-    clock_t randMovementTime;
+    double randMovementTime;
     float enemyRandMoveAngle;
     vec2 momentum;
     float deceleration;
@@ -89,4 +97,6 @@ public:
 	bool stunned;
     vec3 enemyColor;
     vec2 dangerPos;
+	vec2 path_direction = { 0.f, 0.f };
+	PreviousPosition previous_position; // for drawing between simulation steps
 };
\ No newline at end of file
@@ -33,9 +33,7 @@ protected:
 
 	vec2 m_scale; // 1.f in each dimension. 1.f is as big as the associated texture
 	float m_rotation; // in radians
-	float animation_time;
-	TexturedVertex texVertices[4];
-	std::vector<float> texture_locs;
-	bool first_time;
+	SpriteFrame m_frame; // part of the sprite sheet currently displayed
+	AnimationPlayer m_animation;
 };
 
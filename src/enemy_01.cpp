@@ -1,5 +1,7 @@
 // Header
 #include "enemy_01.hpp"
+#include "gl_state.hpp"
+#include "game_random.hpp"
 
 #include <cmath>
 #include <algorithm>
@@ -26,34 +28,27 @@ bool Enemy_01::init(int level)
 	// The position corresponds to the center of the texture
 	float wr = enemy_texture.subWidth * 0.5f;
 	float hr = enemy_texture.subHeight * 0.5f;
-    int rowLength = enemy_texture.width / enemy_texture.subWidth;
-    int colLength = enemy_texture.height / enemy_texture.subHeight;
-    for (int i = 0; i <= rowLength; i++) {
-        float w = (float)i * enemy_texture.subWidth / enemy_texture.width;
-        texture_cols.push_back(w);
-    }
-    for (int j = 0; j <= colLength; j++) {
-        float h = (float)j * enemy_texture.subHeight / enemy_texture.height;
-        texture_rows.push_back(h);
-    }
 
-	texVertices[0].position = { -wr, +hr, -0.02f };
-	texVertices[1].position = { +wr, +hr, -0.02f };
-	texVertices[2].position = { +wr, -hr, -0.02f };
-	texVertices[3].position = { -wr, -hr, -0.02f };
-
-    glGenBuffers(1, &mesh.vbo);
-    glGenBuffers(1, &mesh.ibo);
-    setTextureLocs(4);
+	// Frames and clips are shared by every Enemy_01, walk cycles are authored at 6 frames per second
+	if (enemy_texture.frames.empty())
+	{
+		enemy_texture.build_frames(enemy_texture.width / enemy_texture.subWidth, enemy_texture.height / enemy_texture.subHeight);
+		enemy_texture.animations.add("walk_left", { 4, 4, 1000.f / 6.f, true });
+		enemy_texture.animations.add("walk_right", { 8, 4, 1000.f / 6.f, true });
+	}
 
-	// Vertex Array (Container for Vertex + Index buffer)
-	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors())
+	// The quad is uploaded once, animating only moves the window sampled from the sheet
+	if (!gl_create_sprite_quad(mesh, wr, hr, -0.02f))
 		return false;
+	m_moveState = EnemyMoveState::LEFTMOVING;
+	m_animation = AnimationPlayer();
+	m_animation.play(enemy_texture.animations.find("walk_left"));
+	setTextureLocs(m_animation.get_frame());
 
 	// Loading shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
+	if (!effect.load_from_file(shader_path("animated.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	// Setting initial values, scale is negative to make it face the opposite way
 	// 1.0 would be as big as the original texture
@@ -63,10 +58,10 @@ bool Enemy_01::init(int level)
 	needFireProjectile = false;
 	m_rotation = 0.f;
 	enemyRandMoveAngle = 0.f;
-	lastFireProjectileTime = clock();
-	randMovementTime = clock();
+	lastFireProjectileTime = GameClock::instance().now();
+	randMovementTime = GameClock::instance().now();
 
-	float f = (float)rand() / RAND_MAX;
+	float f = (float)game_rand() / GAME_RAND_MAX;
     float randAttributeFactor = 1.0f + f * (2.0f - 1.0f);
 
 	m_speed = std::min(40.0f + (float)level * 0.35f * randAttributeFactor, 200.0f);
@@ -95,13 +90,9 @@ void Enemy_01::destroy(bool reset)
     glDeleteBuffers(1, &mesh.vbo);
     glDeleteBuffers(1, &mesh.ibo);
 
-    glDeleteShader(effect.vertex);
-    glDeleteShader(effect.fragment);
-    glDeleteShader(effect.program);
 	if((waved && !m_is_alive) || reset) {
 		glDeleteVertexArrays(1, &mesh.vao);
-		glDetachShader(effect.program, effect.vertex);
-		glDetachShader(effect.program, effect.fragment);
+		effect.release();
 		wave.destroy(true);
 	}
 }
@@ -125,38 +116,28 @@ void Enemy_01::draw(const mat3& projection)
 	}
     */
 
-
 	transform_scale(m_scale);
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint uv_offset_uloc = effect.locations->uv_offset;
+	GLint uv_scale_uloc = effect.locations->uv_scale;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, enemy_texture.id);
+	GLState::instance().bind_texture(0, enemy_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
@@ -188,6 +169,7 @@ void Enemy_01::draw(const mat3& projection)
 	enemyColor.z = color[2];
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
+	m_frame.set_uniforms(uv_offset_uloc, uv_scale_uloc);
 
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
@@ -196,29 +178,35 @@ void Enemy_01::draw(const mat3& projection)
 	}
 }
 
+GLuint Enemy_01::get_texture_id()const
+{
+	return enemy_texture.id;
+}
+
 void Enemy_01::update(float ms, vec2 target_pos)
 {
-    float animSpeed = 0.05f;
+	// Knockback is tuned per 60 Hz frame and isn't slowed by stuns
+	float frames = ms / REFERENCE_FRAME_MS;
 
 	//momentum first
 	if (stunned)
 		ms = ms * 0.2f;
 
-	m_position.x += momentum.x;
-	m_position.y += momentum.y;
+	m_position.x += momentum.x * frames;
+	m_position.y += momentum.y * frames;
 
 	if (momentum.x > 0.5f) {
-		momentum.x = std::max(momentum.x - deceleration, 0.f);
+		momentum.x = std::max(momentum.x - deceleration * frames, 0.f);
 	}
 	if (momentum.x < -0.5f) {
-		momentum.x = std::min(momentum.x + deceleration, 0.f);
+		momentum.x = std::min(momentum.x + deceleration * frames, 0.f);
 	}
 
 	if (momentum.y > 0.5f) {
-		momentum.y = std::max(momentum.y - deceleration, 0.f);
+		momentum.y = std::max(momentum.y - deceleration * frames, 0.f);
 	}
 	if (momentum.y < -0.5f) {
-		momentum.y = std::min(momentum.y + deceleration, 0.f);
+		momentum.y = std::min(momentum.y + deceleration * frames, 0.f);
 	}
 
 	// Move fish along -X based on how much time has passed, this is to (partially) avoid
@@ -243,7 +231,7 @@ void Enemy_01::update(float ms, vec2 target_pos)
 	}
 	set_facing(facing);
 	set_rotation(enemy_angle);
-	clock_t currentTime = clock();
+	double currentTime = GameClock::instance().now();
 	if (distance <= 100.f) {
 		needFireProjectile = false;
 		float step = m_speed * (ms / 1000);
@@ -259,7 +247,7 @@ void Enemy_01::update(float ms, vec2 target_pos)
 	} else if (distance <= m_range && checkIfCanFire(currentTime)) {
 		needFireProjectile = true;
 		setLastFireProjectileTime(currentTime);
-		float f = (float)rand() / RAND_MAX;
+		float f = (float)game_rand() / GAME_RAND_MAX;
     	float randAttributeFactor = 1.0f + f * (2.0f - 1.0f);
 		m_range = 50.0 * randAttributeFactor + 475.f;
 	} else if (distance <= m_range) {
@@ -271,13 +259,14 @@ void Enemy_01::update(float ms, vec2 target_pos)
 		needFireProjectile = false;
 
 		float step = -m_speed * (ms / 1000);
-		m_position.x += cos(enemy_angle)*step;
-		m_position.y += sin(enemy_angle)*step;
+		float approach_angle = get_approach_angle(enemy_angle);
+		m_position.x += cos(approach_angle)*step;
+		m_position.y += sin(approach_angle)*step;
 	}
 	if (checkIfCanChangeDirectionOfMove(currentTime)){
 		float LO = enemy_angle - 2.0f;
 		float HI = enemy_angle + 2.0f;
-		enemyRandMoveAngle = LO + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(HI-LO)));
+		enemyRandMoveAngle = LO + static_cast <float> (game_rand()) /( static_cast <float> (GAME_RAND_MAX/(HI-LO)));
 		setRandMovementTime(currentTime);
 		dangerPos = {NULL, NULL};
 	}
@@ -288,32 +277,21 @@ void Enemy_01::update(float ms, vec2 target_pos)
     if (facing == 1) {
         if (m_moveState != EnemyMoveState::RIGHTMOVING) {
             m_moveState = EnemyMoveState::RIGHTMOVING;
-            m_animTime = 0.0f;
+            m_animation.play(enemy_texture.animations.find("walk_right"));
         }
     }
     else {
         if (m_moveState != EnemyMoveState::LEFTMOVING) {
             m_moveState = EnemyMoveState::LEFTMOVING;
-            m_animTime = 0.0f;
+            m_animation.play(enemy_texture.animations.find("walk_left"));
         }
     }
 
-    m_animTime += animSpeed * 2;
-    numTiles = 4;
-
     // setting texture coordinates
-    if (m_moveState == EnemyMoveState::LEFTMOVING) {
-        int currIndex = 4;
-        currIndex += (int)m_animTime % numTiles;
-        setTextureLocs(currIndex);
-    }
-    else if (m_moveState == EnemyMoveState::RIGHTMOVING) {
-        int currIndex = 8;
-        currIndex += (int)m_animTime % numTiles;
-        setTextureLocs(currIndex);
-    }
+    m_animation.update(ms);
+    setTextureLocs(m_animation.get_frame());
 	if (waved) {
-		if (clock() - waveTime > 1500.f){
+		if (GameClock::instance().since(waveTime) > 1500.f){
 			waved = false;
 		} else {
 			wave.update(ms);
@@ -325,39 +303,11 @@ void Enemy_01::update(float ms, vec2 target_pos)
 
 void Enemy_01::setTextureLocs(int index)
 {
-    int colPos = index / 4;
-    int rowPos = index % 4;
-    texVertices[0].texcoord = { texture_cols[rowPos], texture_rows[colPos + 1] }; //top left
-    texVertices[1].texcoord = { texture_cols[rowPos + 1], texture_rows[colPos + 1] }; //top right
-    texVertices[2].texcoord = { texture_cols[rowPos + 1], texture_rows[colPos] }; //bottom right
-    texVertices[3].texcoord = { texture_cols[rowPos], texture_rows[colPos] }; //bottom left
-
-    // counterclockwise as it's the default opengl front winding direction
-    uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-    // Clearing errors
-    gl_flush_errors();
-
-    // Clear memory
-    if (m_is_alive) {
-        destroy(false);
-    }
-
-
-    // Vertex Buffer creation
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
-
-    // Index Buffer creation
-    glGenBuffers(1, &mesh.ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
+    m_frame = enemy_texture.get_frame(index);
 }
 
 bool Enemy_01::shoot_projectiles(std::vector<EnemyLaser> & enemy_projectiles)
 {
-	EnemyLaser enemyLaser;
 	float LO = m_rotation - 0.15f * (float) log((m_level/5) + 1);
 	float HI = m_rotation + 0.15f * (float) log((m_level/5) + 1);
 	if (powerupType == 3) {
@@ -365,24 +315,27 @@ bool Enemy_01::shoot_projectiles(std::vector<EnemyLaser> & enemy_projectiles)
 		HI = m_rotation + 0.05f * (float) log((m_level/5) + 1);
 
 	}
-	float fireDir = LO + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(HI-LO)));
+	float fireDir = LO + static_cast <float> (game_rand()) /( static_cast <float> (GAME_RAND_MAX/(HI-LO)));
 	float variation = 0.f;
 	if (powerupType == 2) {
 		variation = 0.03f;
 	}
+	// Built in place, lasers are move-only
+	enemy_projectiles.emplace_back();
+	EnemyLaser& enemyLaser = enemy_projectiles.back();
 	if (enemyLaser.init(fireDir, projectileSpeed, 10.0f))
 	{
 		enemyLaser.set_position(m_position);
 		enemyLaser.setVariation(variation);
-		enemy_projectiles.emplace_back(enemyLaser);
 		return true;
 	}
+	enemy_projectiles.pop_back();
 	fprintf(stderr, "Failed to spawn fish");
 	return false;
 
 }
 
-bool Enemy_01::checkIfCanFire(clock_t currentClock)
+bool Enemy_01::checkIfCanFire(double currentClock)
 {
 	if ((double)(currentClock - lastFireProjectileTime) > attackCooldown) {
 		return true;
@@ -390,7 +343,7 @@ bool Enemy_01::checkIfCanFire(clock_t currentClock)
 	return false;
 }
 
-void Enemy_01::setLastFireProjectileTime(clock_t c)
+void Enemy_01::setLastFireProjectileTime(double c)
 {
 	lastFireProjectileTime = c;
 }
@@ -398,8 +351,8 @@ void Enemy_01::setLastFireProjectileTime(clock_t c)
 int Enemy_01::powerup()
 {
 	if (!poweredup) {
-		powerupType = 0 + ( std::rand() % ( 3 - 0 + 1 ));
-		float f = (float)rand() / RAND_MAX;
+		powerupType = 0 + ( game_rand() % ( 3 - 0 + 1 ));
+		float f = (float)game_rand() / GAME_RAND_MAX;
 		float randAttributeFactor = 1.0f + f * (2.0f - 1.0f);
 		switch(powerupType){
 			// green
@@ -27,15 +27,17 @@ public:
 	// projection is the 2D orthographic projection matrix
 	void draw(const mat3& projection)override;
 
+	GLuint get_texture_id()const override;
+
     void setTextureLocs(int index);
 
 	bool shoot_projectiles(std::vector<EnemyLaser> & enemy_projectiles);
 
 	bool needFireProjectile;
 
-	void setLastFireProjectileTime(clock_t c);
+	void setLastFireProjectileTime(double c);
 
-	bool checkIfCanFire(clock_t currentClock);
+	bool checkIfCanFire(double currentClock);
 
 	double attackCooldown;
 
@@ -46,14 +48,11 @@ public:
 	vec2 get_bounding_box()const;
 
 	private:
-    std::vector<float> texture_rows;
-    std::vector<float> texture_cols;
-    TexturedVertex texVertices[4];
-	clock_t lastFireProjectileTime;
+    SpriteFrame m_frame; // part of the sprite sheet currently displayed
+	double lastFireProjectileTime;
 	float projectileSpeed;
     EnemyMoveState m_moveState;
-    float m_animTime = 0.0f;
-    int numTiles;
+    AnimationPlayer m_animation;
 	float m_range;
 	int powerupType;
 };
\ No newline at end of file
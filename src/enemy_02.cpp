@@ -1,5 +1,7 @@
 // Header
 #include "enemy_02.hpp"
+#include "gl_state.hpp"
+#include "game_random.hpp"
 
 #include <cmath>
 #include <algorithm>
@@ -27,27 +29,24 @@ bool Enemy_02::init(int level)
 	float wr = enemy_texture.subWidth * 0.5f;
 	float hr = enemy_texture.height * 0.5f;
 
-	texVertices[0].position = { -wr, +hr, -0.02f };
-	texVertices[1].position = { +wr, +hr, -0.02f };
-	texVertices[2].position = { +wr, -hr, -0.02f };
-	texVertices[3].position = { -wr, -hr, -0.02f };
-
-    for (int i = 0; i <= enemy_texture.totalTiles; i++) {
-        texture_locs.push_back((float)i * enemy_texture.subWidth / enemy_texture.width);
-    }
-
-    glGenBuffers(1, &mesh.vbo);
-    glGenBuffers(1, &mesh.ibo);
-    setTextureLocs(0);
+	// Frames and clips are shared by every Enemy_02
+	if (enemy_texture.frames.empty())
+	{
+		enemy_texture.build_frames(enemy_texture.totalTiles);
+		enemy_texture.animations.add("walk", { 0, enemy_texture.totalTiles, 1000.f / 12.f, true });
+	}
 
-	// Vertex Array (Container for Vertex + Index buffer)
-	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors())
+	// The quad is uploaded once, animating only moves the window sampled from the sheet
+	if (!gl_create_sprite_quad(mesh, wr, hr, -0.02f))
 		return false;
+	m_animation = AnimationPlayer();
+	m_animation.play(enemy_texture.animations.find("walk"));
+	setTextureLocs(m_animation.get_frame());
 
 	// Loading shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
+	if (!effect.load_from_file(shader_path("animated.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	// Setting initial values, scale is negative to make it face the opposite way
 	// 1.0 would be as big as the original texture
@@ -55,10 +54,10 @@ bool Enemy_02::init(int level)
 	m_scale.y = 0.8f;
 	m_rotation = 0.f;
 	enemyRandMoveAngle = 0.f;
-	randMovementTime = clock();
+	randMovementTime = GameClock::instance().now();
 	m_is_alive = true;
 
-	float f = (float)rand() / RAND_MAX;
+	float f = (float)game_rand() / GAME_RAND_MAX;
     float randAttributeFactor = 1.0f + f * (2.0f - 1.0f);
 
 	m_speed = std::min(70.0f + (float)level * 0.5f * randAttributeFactor, 400.0f);
@@ -87,13 +86,9 @@ void Enemy_02::destroy(bool reset)
     glDeleteBuffers(1, &mesh.vbo);
     glDeleteBuffers(1, &mesh.ibo);
 
-    glDeleteShader(effect.vertex);
-    glDeleteShader(effect.fragment);
-    glDeleteShader(effect.program);
 	if((waved && !m_is_alive) || reset) {
 		glDeleteVertexArrays(1, &mesh.vao);
-		glDetachShader(effect.program, effect.vertex);
-		glDetachShader(effect.program, effect.fragment);
+		effect.release();
 		wave.destroy(true);
 	}
 }
@@ -121,33 +116,24 @@ void Enemy_02::draw(const mat3& projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
-
-	// Setting texVertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint uv_offset_uloc = effect.locations->uv_offset;
+	GLint uv_scale_uloc = effect.locations->uv_scale;
+
+	// Setting vertices and indices
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, enemy_texture.id);
+	GLState::instance().bind_texture(0, enemy_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
@@ -180,6 +166,7 @@ void Enemy_02::draw(const mat3& projection)
 	enemyColor.z = color[2];
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
+	m_frame.set_uniforms(uv_offset_uloc, uv_scale_uloc);
 
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
@@ -188,29 +175,35 @@ void Enemy_02::draw(const mat3& projection)
 	}
 }
 
+GLuint Enemy_02::get_texture_id()const
+{
+	return enemy_texture.id;
+}
+
 void Enemy_02::update(float ms, vec2 target_pos)
 {
-    float animSpeed = 0.1f;
+	// Knockback is tuned per 60 Hz frame and isn't slowed by stuns
+	float frames = ms / REFERENCE_FRAME_MS;
 
 	//momentum first
 	if (stunned)
 		ms = ms * 0.2;
 
-	m_position.x += momentum.x;
-	m_position.y += momentum.y;
+	m_position.x += momentum.x * frames;
+	m_position.y += momentum.y * frames;
 
 	if (momentum.x > 0.5f) {
-		momentum.x = std::max(momentum.x - deceleration, 0.f);
+		momentum.x = std::max(momentum.x - deceleration * frames, 0.f);
 	}
 	if (momentum.x < -0.5f) {
-		momentum.x = std::min(momentum.x + deceleration, 0.f);
+		momentum.x = std::min(momentum.x + deceleration * frames, 0.f);
 	}
 
 	if (momentum.y > 0.5f) {
-		momentum.y = std::max(momentum.y - deceleration, 0.f);
+		momentum.y = std::max(momentum.y - deceleration * frames, 0.f);
 	}
 	if (momentum.y < -0.5f) {
-		momentum.y = std::min(momentum.y + deceleration, 0.f);
+		momentum.y = std::min(momentum.y + deceleration * frames, 0.f);
 	}
 
 	// Move fish along -X based on how much time has passed, this is to (partially) avoid
@@ -231,7 +224,7 @@ void Enemy_02::update(float ms, vec2 target_pos)
 	}
 	float m_speed_rand_LO = m_speed * 0.8f;
 	float m_speed_rand_HI = m_speed * 1.2f;
-	float m_speed_rand = m_speed_rand_LO + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(m_speed_rand_HI-m_speed_rand_LO)));
+	float m_speed_rand = m_speed_rand_LO + static_cast <float> (game_rand()) /( static_cast <float> (GAME_RAND_MAX/(m_speed_rand_HI-m_speed_rand_LO)));
 	if (speedBoost) {
 		m_speed_rand = m_speed_rand * 2.f;
 	}
@@ -241,20 +234,21 @@ void Enemy_02::update(float ms, vec2 target_pos)
 	}
 	set_facing(facing);
 	set_rotation(enemy_angle);
-	clock_t currentTime = clock();
+	double currentTime = GameClock::instance().now();
 	if (distance <= 100.f) {
 		float step = -1.2f * m_speed_rand * (ms / 1000);
 		m_position.x += cos(enemy_angle)*step;
 		m_position.y += sin(enemy_angle)*step;
 	} else if (distance <= 500.f) {
 		float step = -m_speed_rand * (ms / 1000);
-		float enemyRandMoveAngle_after_variation = enemyRandMoveAngle + sinf((timePassed - clock()) / 200.f) * variation;
+		float enemyRandMoveAngle_after_variation = enemyRandMoveAngle + sinf(-GameClock::instance().since(timePassed) / 200.f) * variation;
 		m_position.x += cos(enemyRandMoveAngle_after_variation)*step;
 		m_position.y += sin(enemyRandMoveAngle_after_variation)*step;
 	} else {
 		float step = -m_speed_rand * (ms / 1000);
-		m_position.x += cos(enemy_angle)*step;
-		m_position.y += sin(enemy_angle)*step;
+		float approach_angle = get_approach_angle(enemy_angle);
+		m_position.x += cos(approach_angle)*step;
+		m_position.y += sin(approach_angle)*step;
 	}
 	if (checkIfCanChangeDirectionOfMove(currentTime) || groupAtk){
 		float LO = enemy_angle - 0.9f;
@@ -263,7 +257,7 @@ void Enemy_02::update(float ms, vec2 target_pos)
 			LO = enemy_angle - 0.2f;
 			HI = enemy_angle + 0.2f;
 		}
-		enemyRandMoveAngle = LO + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(HI-LO)));
+		enemyRandMoveAngle = LO + static_cast <float> (game_rand()) /( static_cast <float> (GAME_RAND_MAX/(HI-LO)));
 		setRandMovementTime(currentTime);
 		if (powerupType == 2 || powerupType == 3) {
 			speedBoost = !speedBoost;
@@ -280,13 +274,10 @@ void Enemy_02::update(float ms, vec2 target_pos)
 	stunned = false;
 
     // update animation loop
-    m_animTime += animSpeed * 2;
-    numTiles = 11;
-    int currIndex = 0;
-    currIndex += (int)m_animTime % numTiles;
-    setTextureLocs(currIndex);
+    m_animation.update(ms);
+    setTextureLocs(m_animation.get_frame());
 	if (waved) {
-		if (clock() - waveTime > 1500.f){
+		if (GameClock::instance().since(waveTime) > 1500.f){
 			waved = false;
 		} else {
 			wave.update(ms);
@@ -297,36 +288,10 @@ void Enemy_02::update(float ms, vec2 target_pos)
 }
 
 void Enemy_02::setTextureLocs(int index) {
-
-    texVertices[0].texcoord = { texture_locs[index], 1.f }; //top left
-    texVertices[1].texcoord = { texture_locs[index + 1], 1.f }; //top right
-    texVertices[2].texcoord = { texture_locs[index + 1], 0.f }; //bottom right
-    texVertices[3].texcoord = { texture_locs[index], 0.f }; //bottom left
-
-    // counterclockwise as it's the default opengl front winding direction
-    uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-    // Clearing errors
-    gl_flush_errors();
-
-    // Clear Memory
-
-    if (m_is_alive) {
-        destroy(false);
-    }
-
-    // Vertex Buffer creation
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
-
-    // Index Buffer creation
-    glGenBuffers(1, &mesh.ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
+	m_frame = enemy_texture.get_frame(index);
 }
 
-bool Enemy_02::checkIfCanFire(clock_t currentClock)
+bool Enemy_02::checkIfCanFire(double currentClock)
 {
 	return false;
 }
@@ -334,8 +299,8 @@ bool Enemy_02::checkIfCanFire(clock_t currentClock)
 int Enemy_02::powerup()
 {
 	if (!poweredup) {
-		powerupType = 0 + ( std::rand() % ( 3 - 0 + 1 ));
-		float f = (float)rand() / RAND_MAX;
+		powerupType = 0 + ( game_rand() % ( 3 - 0 + 1 ));
+		float f = (float)game_rand() / GAME_RAND_MAX;
 		float randAttributeFactor = 1.0f + f * (2.0f - 1.0f);
 		switch(powerupType){
 			// green
@@ -348,7 +313,7 @@ int Enemy_02::powerup()
 				break;
 			// purple
 			case 2:
-			 	timePassed = clock();
+			 	timePassed = GameClock::instance().now();
 				variation = std::min(0.4f + (float)m_level * 0.05f * randAttributeFactor, 1.f);
 				break;
 			// blue
@@ -4,7 +4,7 @@
 #include "enemies.hpp"
 #include "enemy_laser.h"
 #include "projectile.h"
-#include "time.h"
+#include "game_clock.hpp"
 
 // Salmon enemy
 class Enemy_02 :public Enemies
@@ -28,7 +28,9 @@ public:
 	// projection is the 2D orthographic projection matrix
 	void draw(const mat3& projection)override;
 
-	bool checkIfCanFire(clock_t currentClock);
+	GLuint get_texture_id()const override;
+
+	bool checkIfCanFire(double currentClock);
 
     void setTextureLocs(int index);
 
@@ -45,18 +47,14 @@ public:
 	private:
 	int powerupType;
 
-	clock_t timePassed;
+	double timePassed;
 
 	float variation;
 
-    TexturedVertex texVertices[4];
-
-    std::vector<float> texture_locs;
+    SpriteFrame m_frame; // part of the sprite sheet currently displayed
 
     EnemyMoveState m_moveState;
 
-    float m_animTime = 0.0f;
-
-    int numTiles;
+    AnimationPlayer m_animation;
 
 };
\ No newline at end of file
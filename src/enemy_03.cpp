@@ -1,5 +1,7 @@
 // Header
 #include "enemy_03.hpp"
+#include "gl_state.hpp"
+#include "game_random.hpp"
 
 #include <cmath>
 #include <algorithm>
@@ -56,6 +58,7 @@ bool Enemy_03::init(int level)
 	// Loading shaders
 	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	// Setting initial values, scale is negative to make it face the opposite way
 	// 1.0 would be as big as the original texture
@@ -64,11 +67,11 @@ bool Enemy_03::init(int level)
 	needFireProjectile = false;
 	m_rotation = 0.f;
 	enemyRandMoveAngle = 0.f;
-	lastFireProjectileTime = clock();
-	randMovementTime = clock();
+	lastFireProjectileTime = GameClock::instance().now();
+	randMovementTime = GameClock::instance().now();
 	m_is_alive = true;
 
-	float f = (float)rand() / RAND_MAX;
+	float f = (float)game_rand() / GAME_RAND_MAX;
     float randAttributeFactor = 1.0f + f * (2.0f - 1.0f);
 
 	m_speed = std::min(50.0f + (float)level * 0.4f * randAttributeFactor, 140.0f);
@@ -99,9 +102,6 @@ void Enemy_03::destroy(bool reset)
 	glDeleteVertexArrays(1, &mesh.vao);
 	effect.release();
 	if((waved && !m_is_alive) || reset) {
-		glDeleteVertexArrays(1, &mesh.vao);
-		glDetachShader(effect.program, effect.vertex);
-		glDetachShader(effect.program, effect.fragment);
 		wave.destroy(true);
 	}
 }
@@ -124,33 +124,22 @@ void Enemy_03::draw(const mat3& projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, enemy_texture.id);
+	GLState::instance().bind_texture(0, enemy_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
@@ -189,27 +178,35 @@ void Enemy_03::draw(const mat3& projection)
 	}
 }
 
+GLuint Enemy_03::get_texture_id()const
+{
+	return enemy_texture.id;
+}
+
 void Enemy_03::update(float ms, vec2 target_pos)
 {
+	// Knockback is tuned per 60 Hz frame and isn't slowed by stuns
+	float frames = ms / REFERENCE_FRAME_MS;
+
 	//momentum first
 	if (stunned)
 		ms = ms * 0.2f;
 
-	m_position.x += momentum.x;
-	m_position.y += momentum.y;
+	m_position.x += momentum.x * frames;
+	m_position.y += momentum.y * frames;
 
 	if (momentum.x > 0.5f) {
-		momentum.x = std::max(momentum.x - deceleration, 0.f);
+		momentum.x = std::max(momentum.x - deceleration * frames, 0.f);
 	}
 	if (momentum.x < -0.5f) {
-		momentum.x = std::min(momentum.x + deceleration, 0.f);
+		momentum.x = std::min(momentum.x + deceleration * frames, 0.f);
 	}
 
 	if (momentum.y > 0.5f) {
-		momentum.y = std::max(momentum.y - deceleration, 0.f);
+		momentum.y = std::max(momentum.y - deceleration * frames, 0.f);
 	}
 	if (momentum.y < -0.5f) {
-		momentum.y = std::min(momentum.y + deceleration, 0.f);
+		momentum.y = std::min(momentum.y + deceleration * frames, 0.f);
 	}
 
 	// Move fish along -X based on how much time has passed, this is to (partially) avoid
@@ -234,7 +231,7 @@ void Enemy_03::update(float ms, vec2 target_pos)
 	}
 	set_facing(facing);
 	set_rotation(enemy_angle);
-	clock_t currentTime = clock();
+	double currentTime = GameClock::instance().now();
 	if (distance <= 100.f) {
 		needFireProjectile = false;
 		float step = m_speed * (ms / 1000);
@@ -252,20 +249,21 @@ void Enemy_03::update(float ms, vec2 target_pos)
 		needFireProjectile = false;
 
 		float step = -m_speed * (ms / 1000);
-		m_position.x += cos(enemy_angle)*step;
-		m_position.y += sin(enemy_angle)*step;
+		float approach_angle = get_approach_angle(enemy_angle);
+		m_position.x += cos(approach_angle)*step;
+		m_position.y += sin(approach_angle)*step;
 	}
 	if (checkIfCanChangeDirectionOfMove(currentTime)){
 		float LO = enemy_angle - 2.0f;
 		float HI = enemy_angle + 2.0f;
-		enemyRandMoveAngle = LO + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(HI-LO)));
+		enemyRandMoveAngle = LO + static_cast <float> (game_rand()) /( static_cast <float> (GAME_RAND_MAX/(HI-LO)));
 		setRandMovementTime(currentTime);
 		dangerPos = {NULL, NULL};
 	}
 
 	stunned = false;
 	if (waved) {
-		if (clock() - waveTime > 1500.f){
+		if (GameClock::instance().since(waveTime) > 1500.f){
 			waved = false;
 		} else {
 			wave.update(ms);
@@ -276,7 +274,7 @@ void Enemy_03::update(float ms, vec2 target_pos)
 }
 
 
-bool Enemy_03::checkIfCanFire(clock_t currentClock)
+bool Enemy_03::checkIfCanFire(double currentClock)
 {
 	if ((double)(currentClock - lastFireProjectileTime) > attackCooldown) {
 		return true;
@@ -284,7 +282,7 @@ bool Enemy_03::checkIfCanFire(clock_t currentClock)
 	return false;
 }
 
-void Enemy_03::setLastFireProjectileTime(clock_t c)
+void Enemy_03::setLastFireProjectileTime(double c)
 {
 	lastFireProjectileTime = c;
 }
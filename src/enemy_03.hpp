@@ -27,11 +27,13 @@ public:
 	// projection is the 2D orthographic projection matrix
 	void draw(const mat3& projection)override;
 
+	GLuint get_texture_id()const override;
+
 	bool needFireProjectile;
 
-	void setLastFireProjectileTime(clock_t c);
+	void setLastFireProjectileTime(double c);
 
-	bool checkIfCanFire(clock_t currentClock);
+	bool checkIfCanFire(double currentClock);
 
 	double attackCooldown;
 
@@ -39,5 +41,5 @@ public:
 
 	private:
 	float m_range;
-	clock_t lastFireProjectileTime;
+	double lastFireProjectileTime;
 };
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 
 #include "projectile.h"
-#include "time.h"
+#include "game_clock.hpp"
 
 class EnemyLaser: public Projectile
 {
@@ -16,9 +16,6 @@ class EnemyLaser: public Projectile
 public :
     bool init(float radius, float projectileSpeed = 300.f, float damage = 10.0f);
 
-    // Releases all the associated resources
-    void destroy();
-
     void setVariation(float variationf);
 
     // Renders the fish
@@ -30,7 +27,7 @@ public :
     // Returns the fish' bounding box for collision detection, called by collides_with()
     vec2 get_bounding_box()const;
 
-    clock_t timePassed;
+    double timePassed;
 
     private:
 
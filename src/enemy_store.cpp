@@ -0,0 +1,59 @@
+// Header
+#include "enemy_store.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+
+void EnemyStore::gather(std::vector<Enemy_01>& enemys_01, std::vector<Enemy_02>& enemys_02, std::vector<Enemy_03>& enemys_03)
+{
+	positions.clear();
+	radii.clear();
+	alive.clear();
+	kinds.clear();
+	m_entities.clear();
+
+	pack(enemys_01, KIND_01);
+	pack(enemys_02, KIND_02);
+	pack(enemys_03, KIND_03);
+}
+
+template <typename T>
+void EnemyStore::pack(std::vector<T>& enemies, Kind kind)
+{
+	for (auto& enemy : enemies)
+	{
+		if (!enemy.is_alive())
+			continue;
+
+		vec2 box = enemy.get_bounding_box();
+		vec2 scale = enemy.get_scale();
+		positions.push_back(enemy.get_position());
+		radii.push_back(std::max(std::max(box.x, box.y), std::max(std::fabs(scale.x), std::fabs(scale.y))));
+		alive.push_back(1);
+		kinds.push_back(kind);
+		m_entities.push_back(&enemy);
+	}
+}
+
+size_t EnemyStore::size()const
+{
+	return m_entities.size();
+}
+
+Enemies& EnemyStore::get(size_t i)
+{
+	return *m_entities[i];
+}
+
+void EnemyStore::set_position(size_t i, vec2 position)
+{
+	positions[i] = position;
+	m_entities[i]->set_position(position);
+}
+
+bool EnemyStore::update_alive(size_t i)
+{
+	alive[i] = m_entities[i]->is_alive() ? 1 : 0;
+	return alive[i] != 0;
+}
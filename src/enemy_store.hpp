@@ -0,0 +1,55 @@
+#pragma once
+
+#include "common.hpp"
+#include "enemy_01.hpp"
+#include "enemy_02.hpp"
+#include "enemy_03.hpp"
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// Per-tick collision view over World's three enemy vectors, not a storage layer: the enemies
+// keep their whole state (momentum, hp, AI timers, sprites) in their concrete vectors and
+// update there. Once they moved, the store packs what the collision passes read into parallel
+// arrays tagged with the enemy kind, so those passes run as one linear loop over all enemies
+// instead of three copies of the same loop over fat Renderables.
+// Rows point into the enemy vectors and are only valid until one of them changes size.
+class EnemyStore
+{
+public:
+	// Archetype tag of a row, rows are packed in this order
+	enum Kind : uint8_t
+	{
+		KIND_01 = 0,
+		KIND_02,
+		KIND_03,
+		KIND_COUNT
+	};
+
+	// Rebuilds every array from the live enemies
+	void gather(std::vector<Enemy_01>& enemys_01, std::vector<Enemy_02>& enemys_02, std::vector<Enemy_03>& enemys_03);
+
+	size_t size()const;
+
+	// Enemy behind row i, for the per-kind behaviour the store does not carry
+	Enemies& get(size_t i);
+
+	// Moves row i, the enemy follows
+	void set_position(size_t i, vec2 position);
+
+	// Re-reads whether the enemy of row i survived what was just done to it
+	bool update_alive(size_t i);
+
+	// Components, one entry per row
+	std::vector<vec2> positions;
+	std::vector<float> radii; // bounding circle covering every hit test the enemy takes part in
+	std::vector<uint8_t> alive;
+	std::vector<uint8_t> kinds;
+
+private:
+	template <typename T>
+	void pack(std::vector<T>& enemies, Kind kind);
+
+	std::vector<Enemies*> m_entities;
+};
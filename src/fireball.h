@@ -7,6 +7,7 @@
 
 
 #include "projectile.h"
+#include "object_pool.hpp"
 
 class Fireball: public Projectile
 {
@@ -14,12 +15,22 @@ class Fireball: public Projectile
 
 public :
 
+    // Shared by every fireball, World hands spent ones back through destroy()
+    static ObjectPool<Fireball>& pool();
+
+    Fireball()
+    {
+    }
+
     Fireball(float radius, float projectileSpeed = 400.f, float damage = 20.f)
     {
         init(radius,projectileSpeed, damage);
     }
     bool init(float radius, float projectileSpeed, float damage);
 
+    // Returns the projectile to the pool
+    void destroy() override;
+
     // Renders the fish
     // projection is the 2D orthographic projection matrix
     void draw(const mat3& projection) override;
@@ -0,0 +1,149 @@
+// Header
+#include "flow_field.hpp"
+
+// stlib
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+	const int NEIGHBOUR_X[] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	const int NEIGHBOUR_Y[] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+	const float DIAGONAL_COST = 1.41421356f;
+}
+
+FlowField::FlowField(float cell_size) :
+	m_origin({ 0.f, 0.f }),
+	m_cell_size(cell_size),
+	m_cols(0),
+	m_rows(0),
+	m_target(-1)
+{
+}
+
+void FlowField::build(vec2 origin, vec2 size, const ObstacleField& obstacles, float clearance)
+{
+	m_origin = origin;
+	m_cols = std::max(1, (int)std::ceil(size.x / m_cell_size));
+	m_rows = std::max(1, (int)std::ceil(size.y / m_cell_size));
+
+	size_t cells = (size_t)m_cols * (size_t)m_rows;
+	m_blocked.assign(cells, 0);
+	m_costs.assign(cells, FLT_MAX);
+	m_next.assign(cells, -1);
+	for (size_t i = 0; i < cells; ++i)
+	{
+		ObstacleField::Sample sample;
+		if (obstacles.sample(center_of((int)i), sample) && sample.distance < clearance)
+			m_blocked[i] = 1;
+	}
+
+	// Obstacles changed, the next update has to search again
+	m_target = -1;
+}
+
+void FlowField::clear()
+{
+	m_blocked.clear();
+	m_costs.clear();
+	m_next.clear();
+	m_cols = 0;
+	m_rows = 0;
+	m_target = -1;
+}
+
+void FlowField::update(vec2 target)
+{
+	int cell = cell_of(target);
+	if (cell == m_target)
+		return;
+
+	m_target = cell;
+	std::fill(m_costs.begin(), m_costs.end(), FLT_MAX);
+	std::fill(m_next.begin(), m_next.end(), -1);
+	if (cell >= 0)
+		search(cell);
+}
+
+vec2 FlowField::direction(vec2 position)const
+{
+	int cell = cell_of(position);
+	if (cell < 0 || m_next[cell] < 0)
+		return { 0.f, 0.f };
+
+	// Toward the center of the next cell rather than along the grid, so paths don't zigzag
+	vec2 next = center_of(m_next[cell]);
+	vec2 d = { next.x - position.x, next.y - position.y };
+	float length = std::sqrt(d.x * d.x + d.y * d.y);
+	if (length < 1e-3f)
+		return { 0.f, 0.f };
+	return { d.x / length, d.y / length };
+}
+
+int FlowField::cell_of(vec2 position)const
+{
+	if (m_cols == 0)
+		return -1;
+
+	int x = (int)std::floor((position.x - m_origin.x) / m_cell_size);
+	int y = (int)std::floor((position.y - m_origin.y) / m_cell_size);
+	if (x < 0 || y < 0 || x >= m_cols || y >= m_rows)
+		return -1;
+	return y * m_cols + x;
+}
+
+vec2 FlowField::center_of(int cell)const
+{
+	int x = cell % m_cols;
+	int y = cell / m_cols;
+	return { m_origin.x + (x + 0.5f) * m_cell_size, m_origin.y + (y + 0.5f) * m_cell_size };
+}
+
+void FlowField::search(int target)
+{
+	// Dijkstra from the target, 8-connected without cutting the corners of blocked cells
+	typedef std::pair<float, int> Entry;
+	m_open.clear();
+	m_costs[target] = 0.f;
+	m_open.push_back(Entry(0.f, target));
+
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+		Entry current = m_open.back();
+		m_open.pop_back();
+		int cell = current.second;
+		if (current.first > m_costs[cell])
+			continue;
+
+		int x = cell % m_cols;
+		int y = cell / m_cols;
+		for (int n = 0; n < 8; ++n)
+		{
+			int nx = x + NEIGHBOUR_X[n];
+			int ny = y + NEIGHBOUR_Y[n];
+			if (nx < 0 || ny < 0 || nx >= m_cols || ny >= m_rows)
+				continue;
+
+			int neighbour = ny * m_cols + nx;
+			bool diagonal = n >= 4;
+			if (diagonal && (m_blocked[y * m_cols + nx] || m_blocked[ny * m_cols + x]))
+				continue;
+
+			// Blocked cells still get a way out, they just never lead anywhere
+			float cost = current.first + (diagonal ? DIAGONAL_COST : 1.f);
+			if (cost < m_costs[neighbour])
+			{
+				m_costs[neighbour] = cost;
+				m_next[neighbour] = cell;
+				if (!m_blocked[neighbour])
+				{
+					m_open.push_back(Entry(cost, neighbour));
+					std::push_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "common.hpp"
+#include "obstacle_field.hpp"
+
+// stlib
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Shortest paths toward a single target (the hero) over a coarse grid of the level, shared by
+// every enemy. The search runs from the target's cell outwards and only when the target moves
+// to another cell, after that each cell knows which neighbour to head for, so steering an
+// enemy is a lookup whatever the number of enemies.
+class FlowField
+{
+public:
+	explicit FlowField(float cell_size = 32.f);
+
+	// Covers the rectangle at origin of the given size. Cells whose center is closer than
+	// clearance to an obstacle are blocked.
+	void build(vec2 origin, vec2 size, const ObstacleField& obstacles, float clearance);
+
+	void clear();
+
+	// Searches again from the cell of target, unless it's the same one as last time
+	void update(vec2 target);
+
+	// Unit direction to move along from position to get to the target around obstacles.
+	// Zero in the target cell, outside the grid and where the target can't be reached.
+	vec2 direction(vec2 position)const;
+
+private:
+	// -1 outside the grid
+	int cell_of(vec2 position)const;
+	vec2 center_of(int cell)const;
+
+	void search(int target);
+
+	std::vector<uint8_t> m_blocked;
+	std::vector<float> m_costs;
+	std::vector<int> m_next; // neighbour on the way to the target, -1 if none
+	std::vector<std::pair<float, int>> m_open; // binary heap, kept between searches
+	vec2 m_origin;
+	float m_cell_size;
+	int m_cols;
+	int m_rows;
+	int m_target;
+};
@@ -0,0 +1,178 @@
+// Header
+#include "font_atlas.hpp"
+#include "headless_gl.hpp"
+
+// stlib
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	// Rows of glyphs are packed into a texture of this width, the height grows to fit
+	const int ATLAS_WIDTH = 512;
+
+	// Empty texels around every bitmap so linear filtering never reads the neighbours
+	const int GLYPH_PADDING = 1;
+}
+
+const int FontAtlas::GLYPH_COUNT;
+
+FontAtlas::FontAtlas() :
+	texture(0),
+	width(0),
+	height(0)
+{
+
+}
+
+bool FontAtlas::load(const char* path, int pixel_size)
+{
+	// Text is only drawn, an empty atlas is enough to step the world
+	if (is_headless_gl())
+	{
+		std::fill(glyphs, glyphs + GLYPH_COUNT, Glyph());
+		return true;
+	}
+
+	FT_Library ft;
+	if (FT_Init_FreeType(&ft))
+	{
+		fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+		return false;
+	}
+
+	FT_Face face;
+	if (FT_New_Face(ft, path, 0, &face))
+	{
+		fprintf(stderr, "ERROR::FREETYPE: Failed to load font %s\n", path);
+		FT_Done_FreeType(ft);
+		return false;
+	}
+
+	FT_Set_Pixel_Sizes(face, 0, pixel_size);
+
+	// First pass rasterizes every glyph and assigns it a spot on a shelf
+	std::vector<std::vector<unsigned char>> bitmaps(GLYPH_COUNT);
+	int pen_x = GLYPH_PADDING;
+	int pen_y = GLYPH_PADDING;
+	int row_height = 0;
+	int positions[GLYPH_COUNT][2];
+	for (int c = 0; c < GLYPH_COUNT; ++c)
+	{
+		if (FT_Load_Char(face, c, FT_LOAD_RENDER))
+		{
+			fprintf(stderr, "ERROR::FREETYPE: Failed to load Glyph\n");
+			FT_Done_Face(face);
+			FT_Done_FreeType(ft);
+			return false;
+		}
+
+		const FT_Bitmap& bitmap = face->glyph->bitmap;
+		int w = (int)bitmap.width;
+		int h = (int)bitmap.rows;
+		if (pen_x + w + GLYPH_PADDING > ATLAS_WIDTH)
+		{
+			pen_x = GLYPH_PADDING;
+			pen_y += row_height + GLYPH_PADDING;
+			row_height = 0;
+		}
+
+		// FreeType rows may be padded, copy them tightly
+		bitmaps[c].resize(w * h);
+		for (int row = 0; row < h; ++row)
+			std::copy(bitmap.buffer + row * bitmap.pitch, bitmap.buffer + row * bitmap.pitch + w, bitmaps[c].begin() + row * w);
+
+		positions[c][0] = pen_x;
+		positions[c][1] = pen_y;
+
+		Glyph& glyph = glyphs[c];
+		glyph.size = { (float)w, (float)h };
+		glyph.bearing = { (float)face->glyph->bitmap_left, (float)face->glyph->bitmap_top };
+		glyph.advance = (float)(face->glyph->advance.x >> 6); // advance is in 1/64 pixels
+
+		pen_x += w + GLYPH_PADDING;
+		row_height = std::max(row_height, h);
+	}
+
+	FT_Done_Face(face);
+	FT_Done_FreeType(ft);
+
+	width = ATLAS_WIDTH;
+	height = pen_y + row_height + GLYPH_PADDING;
+
+	// Second pass copies the bitmaps into the atlas now that its size is known
+	std::vector<unsigned char> texels(width * height, 0);
+	for (int c = 0; c < GLYPH_COUNT; ++c)
+	{
+		Glyph& glyph = glyphs[c];
+		int x = positions[c][0];
+		int y = positions[c][1];
+		int w = (int)glyph.size.x;
+		int h = (int)glyph.size.y;
+		for (int row = 0; row < h; ++row)
+			std::copy(bitmaps[c].begin() + row * w, bitmaps[c].begin() + (row + 1) * w, texels.begin() + (y + row) * width + x);
+
+		glyph.uv_min = { (float)x / width, (float)y / height };
+		glyph.uv_max = { (float)(x + w) / width, (float)(y + h) / height };
+	}
+
+	gl_flush_errors();
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, texels.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (gl_has_errors())
+	{
+		destroy();
+		return false;
+	}
+	return true;
+}
+
+void FontAtlas::destroy()
+{
+	if (texture != 0)
+		glDeleteTextures(1, &texture);
+	texture = 0;
+}
+
+const Glyph& FontAtlas::get_glyph(char c)const
+{
+	int index = (unsigned char)c;
+	if (index >= GLYPH_COUNT)
+		index = '?';
+	return glyphs[index];
+}
+
+FontCache& FontCache::instance()
+{
+	static FontCache cache;
+	return cache;
+}
+
+const FontAtlas* FontCache::get(const char* path, int pixel_size)
+{
+	Key key(path, pixel_size);
+	auto it = m_atlases.find(key);
+	if (it != m_atlases.end())
+		return &it->second;
+
+	FontAtlas atlas;
+	if (!atlas.load(path, pixel_size))
+		return nullptr;
+	return &m_atlases.insert(std::make_pair(key, atlas)).first->second;
+}
+
+void FontCache::clear()
+{
+	for (auto& pair : m_atlases)
+		pair.second.destroy();
+	m_atlases.clear();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <map>
+#include <string>
+#include <utility>
+
+// Metrics of a rasterized character and the window of the atlas holding its bitmap
+struct Glyph
+{
+	vec2 size;       // Size of the bitmap in pixels
+	vec2 bearing;    // Offset from baseline to left/top of the bitmap
+	float advance;   // Offset to the next glyph in pixels
+	vec2 uv_min;
+	vec2 uv_max;
+};
+
+// Every ASCII glyph of a font at one pixel size, packed row by row into a single
+// single-channel texture so a whole string can be drawn without switching textures.
+struct FontAtlas
+{
+	static const int GLYPH_COUNT = 128;
+
+	FontAtlas();
+
+	// Rasterizes the glyphs with FreeType and uploads the packed atlas
+	bool load(const char* path, int pixel_size);
+	void destroy();
+
+	// Glyph used for c, characters outside the atlas map to '?'
+	const Glyph& get_glyph(char c)const;
+
+	GLuint texture;
+	int width;
+	int height;
+	Glyph glyphs[GLYPH_COUNT];
+};
+
+// Process-wide cache of font atlases keyed by (font path, pixel size). Every Text using the
+// same font shares one atlas, which lives until clear() is called on shutdown.
+class FontCache
+{
+public:
+	static FontCache& instance();
+
+	// Atlas for the font at path rasterized at pixel_size, built on first use. nullptr on failure.
+	const FontAtlas* get(const char* path, int pixel_size);
+
+	// Deletes every atlas, must run while the GL context is alive
+	void clear();
+
+private:
+	FontCache() {}
+	FontCache(const FontCache&) = delete;
+	FontCache& operator=(const FontCache&) = delete;
+
+	typedef std::pair<std::string, int> Key;
+
+	std::map<Key, FontAtlas> m_atlases;
+};
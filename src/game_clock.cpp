@@ -0,0 +1,51 @@
+// Header
+#include "game_clock.hpp"
+
+GameClock& GameClock::instance()
+{
+	static GameClock clock;
+	return clock;
+}
+
+GameClock::GameClock() :
+	m_now(0.0),
+	m_time_scale(1.f),
+	m_paused(false)
+{
+}
+
+void GameClock::tick(float ms)
+{
+	if (!m_paused)
+		m_now += (double)ms * m_time_scale;
+}
+
+double GameClock::now()const
+{
+	return m_now;
+}
+
+float GameClock::since(double time)const
+{
+	return (float)(m_now - time);
+}
+
+void GameClock::set_paused(bool paused)
+{
+	m_paused = paused;
+}
+
+bool GameClock::is_paused()const
+{
+	return m_paused;
+}
+
+void GameClock::set_time_scale(float scale)
+{
+	m_time_scale = scale;
+}
+
+float GameClock::get_time_scale()const
+{
+	return m_time_scale;
+}
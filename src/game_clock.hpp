@@ -0,0 +1,36 @@
+#pragma once
+
+// Gameplay time in milliseconds, advanced once per World::update by the simulated step.
+// Cooldowns and timers read it instead of clock(), which measures process CPU time and
+// drifts with load. Stops while paused and runs at the time scale of the game speed.
+// Never goes back, timestamps kept across a restart (the hero's fire cooldown, the water's
+// death time) stay in the past.
+class GameClock
+{
+public:
+	static GameClock& instance();
+
+	// Moves the clock ahead by ms scaled by the time scale, unless paused
+	void tick(float ms);
+
+	// Current game time in milliseconds, only changes on tick()
+	double now()const;
+
+	// Milliseconds of game time since a value previously returned by now()
+	float since(double time)const;
+
+	void set_paused(bool paused);
+	bool is_paused()const;
+
+	void set_time_scale(float scale);
+	float get_time_scale()const;
+
+private:
+	GameClock();
+	GameClock(const GameClock&) = delete;
+	GameClock& operator=(const GameClock&) = delete;
+
+	double m_now; // double so hours of play keep sub-millisecond precision
+	float m_time_scale;
+	bool m_paused;
+};
@@ -0,0 +1,21 @@
+// Header
+#include "game_random.hpp"
+
+namespace
+{
+	// xorshift32, the state must never be 0
+	uint32_t state = 2463534242u;
+}
+
+void game_srand(uint32_t seed)
+{
+	state = (seed != 0) ? seed : 2463534242u;
+}
+
+int game_rand()
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return (int)(state & (uint32_t)GAME_RAND_MAX);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+
+// Gameplay randomness goes through here instead of rand(), so a session is reproduced from
+// its seed on every platform. Same contract as rand(): not thread safe, only called from the
+// main thread (enemy AI included) so the draw order is the same on every run.
+const int GAME_RAND_MAX = 0x7fffffff;
+
+// Restarts the sequence, 0 is mapped to another seed
+void game_srand(uint32_t seed);
+
+// Next number in [0, GAME_RAND_MAX]
+int game_rand();
@@ -0,0 +1,1244 @@
+// Every entry point declared by ext/gl3w/gl3w.h, without the gl prefix, one GL3W_PROC(name)
+// per line. Generated from the header's extern declarations, regenerate along with it:
+//   grep -oP '^extern PFN\w+PROC\s+gl3w\K\w+(?=;)' ext/gl3w/gl3w.h | sed 's/.*/GL3W_PROC(&)/'
+
+GL3W_PROC(ActiveProgramEXT)
+GL3W_PROC(ActiveShaderProgram)
+GL3W_PROC(ActiveTexture)
+GL3W_PROC(ApplyFramebufferAttachmentCMAAINTEL)
+GL3W_PROC(AttachShader)
+GL3W_PROC(BeginConditionalRender)
+GL3W_PROC(BeginConditionalRenderNV)
+GL3W_PROC(BeginPerfMonitorAMD)
+GL3W_PROC(BeginPerfQueryINTEL)
+GL3W_PROC(BeginQuery)
+GL3W_PROC(BeginQueryIndexed)
+GL3W_PROC(BeginTransformFeedback)
+GL3W_PROC(BindAttribLocation)
+GL3W_PROC(BindBuffer)
+GL3W_PROC(BindBufferBase)
+GL3W_PROC(BindBufferRange)
+GL3W_PROC(BindBuffersBase)
+GL3W_PROC(BindBuffersRange)
+GL3W_PROC(BindFragDataLocation)
+GL3W_PROC(BindFragDataLocationIndexed)
+GL3W_PROC(BindFramebuffer)
+GL3W_PROC(BindImageTexture)
+GL3W_PROC(BindImageTextures)
+GL3W_PROC(BindMultiTextureEXT)
+GL3W_PROC(BindProgramPipeline)
+GL3W_PROC(BindRenderbuffer)
+GL3W_PROC(BindSampler)
+GL3W_PROC(BindSamplers)
+GL3W_PROC(BindTexture)
+GL3W_PROC(BindTextureUnit)
+GL3W_PROC(BindTextures)
+GL3W_PROC(BindTransformFeedback)
+GL3W_PROC(BindVertexArray)
+GL3W_PROC(BindVertexBuffer)
+GL3W_PROC(BindVertexBuffers)
+GL3W_PROC(BlendBarrierKHR)
+GL3W_PROC(BlendBarrierNV)
+GL3W_PROC(BlendColor)
+GL3W_PROC(BlendEquation)
+GL3W_PROC(BlendEquationSeparate)
+GL3W_PROC(BlendEquationSeparatei)
+GL3W_PROC(BlendEquationSeparateiARB)
+GL3W_PROC(BlendEquationi)
+GL3W_PROC(BlendEquationiARB)
+GL3W_PROC(BlendFunc)
+GL3W_PROC(BlendFuncSeparate)
+GL3W_PROC(BlendFuncSeparatei)
+GL3W_PROC(BlendFuncSeparateiARB)
+GL3W_PROC(BlendFunci)
+GL3W_PROC(BlendFunciARB)
+GL3W_PROC(BlendParameteriNV)
+GL3W_PROC(BlitFramebuffer)
+GL3W_PROC(BlitNamedFramebuffer)
+GL3W_PROC(BufferAddressRangeNV)
+GL3W_PROC(BufferData)
+GL3W_PROC(BufferPageCommitmentARB)
+GL3W_PROC(BufferStorage)
+GL3W_PROC(BufferSubData)
+GL3W_PROC(CallCommandListNV)
+GL3W_PROC(CheckFramebufferStatus)
+GL3W_PROC(CheckNamedFramebufferStatus)
+GL3W_PROC(CheckNamedFramebufferStatusEXT)
+GL3W_PROC(ClampColor)
+GL3W_PROC(Clear)
+GL3W_PROC(ClearBufferData)
+GL3W_PROC(ClearBufferSubData)
+GL3W_PROC(ClearBufferfi)
+GL3W_PROC(ClearBufferfv)
+GL3W_PROC(ClearBufferiv)
+GL3W_PROC(ClearBufferuiv)
+GL3W_PROC(ClearColor)
+GL3W_PROC(ClearDepth)
+GL3W_PROC(ClearDepthf)
+GL3W_PROC(ClearNamedBufferData)
+GL3W_PROC(ClearNamedBufferDataEXT)
+GL3W_PROC(ClearNamedBufferSubData)
+GL3W_PROC(ClearNamedBufferSubDataEXT)
+GL3W_PROC(ClearNamedFramebufferfi)
+GL3W_PROC(ClearNamedFramebufferfv)
+GL3W_PROC(ClearNamedFramebufferiv)
+GL3W_PROC(ClearNamedFramebufferuiv)
+GL3W_PROC(ClearStencil)
+GL3W_PROC(ClearTexImage)
+GL3W_PROC(ClearTexSubImage)
+GL3W_PROC(ClientAttribDefaultEXT)
+GL3W_PROC(ClientWaitSync)
+GL3W_PROC(ClipControl)
+GL3W_PROC(ColorFormatNV)
+GL3W_PROC(ColorMask)
+GL3W_PROC(ColorMaski)
+GL3W_PROC(CommandListSegmentsNV)
+GL3W_PROC(CompileCommandListNV)
+GL3W_PROC(CompileShader)
+GL3W_PROC(CompileShaderIncludeARB)
+GL3W_PROC(CompressedMultiTexImage1DEXT)
+GL3W_PROC(CompressedMultiTexImage2DEXT)
+GL3W_PROC(CompressedMultiTexImage3DEXT)
+GL3W_PROC(CompressedMultiTexSubImage1DEXT)
+GL3W_PROC(CompressedMultiTexSubImage2DEXT)
+GL3W_PROC(CompressedMultiTexSubImage3DEXT)
+GL3W_PROC(CompressedTexImage1D)
+GL3W_PROC(CompressedTexImage2D)
+GL3W_PROC(CompressedTexImage3D)
+GL3W_PROC(CompressedTexSubImage1D)
+GL3W_PROC(CompressedTexSubImage2D)
+GL3W_PROC(CompressedTexSubImage3D)
+GL3W_PROC(CompressedTextureImage1DEXT)
+GL3W_PROC(CompressedTextureImage2DEXT)
+GL3W_PROC(CompressedTextureImage3DEXT)
+GL3W_PROC(CompressedTextureSubImage1D)
+GL3W_PROC(CompressedTextureSubImage1DEXT)
+GL3W_PROC(CompressedTextureSubImage2D)
+GL3W_PROC(CompressedTextureSubImage2DEXT)
+GL3W_PROC(CompressedTextureSubImage3D)
+GL3W_PROC(CompressedTextureSubImage3DEXT)
+GL3W_PROC(ConservativeRasterParameterfNV)
+GL3W_PROC(ConservativeRasterParameteriNV)
+GL3W_PROC(CopyBufferSubData)
+GL3W_PROC(CopyImageSubData)
+GL3W_PROC(CopyMultiTexImage1DEXT)
+GL3W_PROC(CopyMultiTexImage2DEXT)
+GL3W_PROC(CopyMultiTexSubImage1DEXT)
+GL3W_PROC(CopyMultiTexSubImage2DEXT)
+GL3W_PROC(CopyMultiTexSubImage3DEXT)
+GL3W_PROC(CopyNamedBufferSubData)
+GL3W_PROC(CopyPathNV)
+GL3W_PROC(CopyTexImage1D)
+GL3W_PROC(CopyTexImage2D)
+GL3W_PROC(CopyTexSubImage1D)
+GL3W_PROC(CopyTexSubImage2D)
+GL3W_PROC(CopyTexSubImage3D)
+GL3W_PROC(CopyTextureImage1DEXT)
+GL3W_PROC(CopyTextureImage2DEXT)
+GL3W_PROC(CopyTextureSubImage1D)
+GL3W_PROC(CopyTextureSubImage1DEXT)
+GL3W_PROC(CopyTextureSubImage2D)
+GL3W_PROC(CopyTextureSubImage2DEXT)
+GL3W_PROC(CopyTextureSubImage3D)
+GL3W_PROC(CopyTextureSubImage3DEXT)
+GL3W_PROC(CoverFillPathInstancedNV)
+GL3W_PROC(CoverFillPathNV)
+GL3W_PROC(CoverStrokePathInstancedNV)
+GL3W_PROC(CoverStrokePathNV)
+GL3W_PROC(CoverageModulationNV)
+GL3W_PROC(CoverageModulationTableNV)
+GL3W_PROC(CreateBuffers)
+GL3W_PROC(CreateCommandListsNV)
+GL3W_PROC(CreateFramebuffers)
+GL3W_PROC(CreatePerfQueryINTEL)
+GL3W_PROC(CreateProgram)
+GL3W_PROC(CreateProgramPipelines)
+GL3W_PROC(CreateQueries)
+GL3W_PROC(CreateRenderbuffers)
+GL3W_PROC(CreateSamplers)
+GL3W_PROC(CreateShader)
+GL3W_PROC(CreateShaderProgramEXT)
+GL3W_PROC(CreateShaderProgramv)
+GL3W_PROC(CreateStatesNV)
+GL3W_PROC(CreateSyncFromCLeventARB)
+GL3W_PROC(CreateTextures)
+GL3W_PROC(CreateTransformFeedbacks)
+GL3W_PROC(CreateVertexArrays)
+GL3W_PROC(CullFace)
+GL3W_PROC(DebugMessageCallback)
+GL3W_PROC(DebugMessageCallbackARB)
+GL3W_PROC(DebugMessageControl)
+GL3W_PROC(DebugMessageControlARB)
+GL3W_PROC(DebugMessageInsert)
+GL3W_PROC(DebugMessageInsertARB)
+GL3W_PROC(DeleteBuffers)
+GL3W_PROC(DeleteCommandListsNV)
+GL3W_PROC(DeleteFramebuffers)
+GL3W_PROC(DeleteNamedStringARB)
+GL3W_PROC(DeletePathsNV)
+GL3W_PROC(DeletePerfMonitorsAMD)
+GL3W_PROC(DeletePerfQueryINTEL)
+GL3W_PROC(DeleteProgram)
+GL3W_PROC(DeleteProgramPipelines)
+GL3W_PROC(DeleteQueries)
+GL3W_PROC(DeleteRenderbuffers)
+GL3W_PROC(DeleteSamplers)
+GL3W_PROC(DeleteShader)
+GL3W_PROC(DeleteStatesNV)
+GL3W_PROC(DeleteSync)
+GL3W_PROC(DeleteTextures)
+GL3W_PROC(DeleteTransformFeedbacks)
+GL3W_PROC(DeleteVertexArrays)
+GL3W_PROC(DepthFunc)
+GL3W_PROC(DepthMask)
+GL3W_PROC(DepthRange)
+GL3W_PROC(DepthRangeArrayv)
+GL3W_PROC(DepthRangeIndexed)
+GL3W_PROC(DepthRangef)
+GL3W_PROC(DetachShader)
+GL3W_PROC(Disable)
+GL3W_PROC(DisableClientStateIndexedEXT)
+GL3W_PROC(DisableClientStateiEXT)
+GL3W_PROC(DisableIndexedEXT)
+GL3W_PROC(DisableVertexArrayAttrib)
+GL3W_PROC(DisableVertexArrayAttribEXT)
+GL3W_PROC(DisableVertexArrayEXT)
+GL3W_PROC(DisableVertexAttribArray)
+GL3W_PROC(Disablei)
+GL3W_PROC(DispatchCompute)
+GL3W_PROC(DispatchComputeGroupSizeARB)
+GL3W_PROC(DispatchComputeIndirect)
+GL3W_PROC(DrawArrays)
+GL3W_PROC(DrawArraysIndirect)
+GL3W_PROC(DrawArraysInstanced)
+GL3W_PROC(DrawArraysInstancedARB)
+GL3W_PROC(DrawArraysInstancedBaseInstance)
+GL3W_PROC(DrawArraysInstancedEXT)
+GL3W_PROC(DrawBuffer)
+GL3W_PROC(DrawBuffers)
+GL3W_PROC(DrawCommandsAddressNV)
+GL3W_PROC(DrawCommandsNV)
+GL3W_PROC(DrawCommandsStatesAddressNV)
+GL3W_PROC(DrawCommandsStatesNV)
+GL3W_PROC(DrawElements)
+GL3W_PROC(DrawElementsBaseVertex)
+GL3W_PROC(DrawElementsIndirect)
+GL3W_PROC(DrawElementsInstanced)
+GL3W_PROC(DrawElementsInstancedARB)
+GL3W_PROC(DrawElementsInstancedBaseInstance)
+GL3W_PROC(DrawElementsInstancedBaseVertex)
+GL3W_PROC(DrawElementsInstancedBaseVertexBaseInstance)
+GL3W_PROC(DrawElementsInstancedEXT)
+GL3W_PROC(DrawRangeElements)
+GL3W_PROC(DrawRangeElementsBaseVertex)
+GL3W_PROC(DrawTransformFeedback)
+GL3W_PROC(DrawTransformFeedbackInstanced)
+GL3W_PROC(DrawTransformFeedbackStream)
+GL3W_PROC(DrawTransformFeedbackStreamInstanced)
+GL3W_PROC(DrawVkImageNV)
+GL3W_PROC(EdgeFlagFormatNV)
+GL3W_PROC(Enable)
+GL3W_PROC(EnableClientStateIndexedEXT)
+GL3W_PROC(EnableClientStateiEXT)
+GL3W_PROC(EnableIndexedEXT)
+GL3W_PROC(EnableVertexArrayAttrib)
+GL3W_PROC(EnableVertexArrayAttribEXT)
+GL3W_PROC(EnableVertexArrayEXT)
+GL3W_PROC(EnableVertexAttribArray)
+GL3W_PROC(Enablei)
+GL3W_PROC(EndConditionalRender)
+GL3W_PROC(EndConditionalRenderNV)
+GL3W_PROC(EndPerfMonitorAMD)
+GL3W_PROC(EndPerfQueryINTEL)
+GL3W_PROC(EndQuery)
+GL3W_PROC(EndQueryIndexed)
+GL3W_PROC(EndTransformFeedback)
+GL3W_PROC(EvaluateDepthValuesARB)
+GL3W_PROC(FenceSync)
+GL3W_PROC(Finish)
+GL3W_PROC(Flush)
+GL3W_PROC(FlushMappedBufferRange)
+GL3W_PROC(FlushMappedNamedBufferRange)
+GL3W_PROC(FlushMappedNamedBufferRangeEXT)
+GL3W_PROC(FogCoordFormatNV)
+GL3W_PROC(FragmentCoverageColorNV)
+GL3W_PROC(FramebufferDrawBufferEXT)
+GL3W_PROC(FramebufferDrawBuffersEXT)
+GL3W_PROC(FramebufferParameteri)
+GL3W_PROC(FramebufferReadBufferEXT)
+GL3W_PROC(FramebufferRenderbuffer)
+GL3W_PROC(FramebufferSampleLocationsfvARB)
+GL3W_PROC(FramebufferSampleLocationsfvNV)
+GL3W_PROC(FramebufferTexture)
+GL3W_PROC(FramebufferTexture1D)
+GL3W_PROC(FramebufferTexture2D)
+GL3W_PROC(FramebufferTexture3D)
+GL3W_PROC(FramebufferTextureARB)
+GL3W_PROC(FramebufferTextureFaceARB)
+GL3W_PROC(FramebufferTextureLayer)
+GL3W_PROC(FramebufferTextureLayerARB)
+GL3W_PROC(FramebufferTextureMultiviewOVR)
+GL3W_PROC(FrontFace)
+GL3W_PROC(GenBuffers)
+GL3W_PROC(GenFramebuffers)
+GL3W_PROC(GenPathsNV)
+GL3W_PROC(GenPerfMonitorsAMD)
+GL3W_PROC(GenProgramPipelines)
+GL3W_PROC(GenQueries)
+GL3W_PROC(GenRenderbuffers)
+GL3W_PROC(GenSamplers)
+GL3W_PROC(GenTextures)
+GL3W_PROC(GenTransformFeedbacks)
+GL3W_PROC(GenVertexArrays)
+GL3W_PROC(GenerateMipmap)
+GL3W_PROC(GenerateMultiTexMipmapEXT)
+GL3W_PROC(GenerateTextureMipmap)
+GL3W_PROC(GenerateTextureMipmapEXT)
+GL3W_PROC(GetActiveAtomicCounterBufferiv)
+GL3W_PROC(GetActiveAttrib)
+GL3W_PROC(GetActiveSubroutineName)
+GL3W_PROC(GetActiveSubroutineUniformName)
+GL3W_PROC(GetActiveSubroutineUniformiv)
+GL3W_PROC(GetActiveUniform)
+GL3W_PROC(GetActiveUniformBlockName)
+GL3W_PROC(GetActiveUniformBlockiv)
+GL3W_PROC(GetActiveUniformName)
+GL3W_PROC(GetActiveUniformsiv)
+GL3W_PROC(GetAttachedShaders)
+GL3W_PROC(GetAttribLocation)
+GL3W_PROC(GetBooleanIndexedvEXT)
+GL3W_PROC(GetBooleani_v)
+GL3W_PROC(GetBooleanv)
+GL3W_PROC(GetBufferParameteri64v)
+GL3W_PROC(GetBufferParameteriv)
+GL3W_PROC(GetBufferParameterui64vNV)
+GL3W_PROC(GetBufferPointerv)
+GL3W_PROC(GetBufferSubData)
+GL3W_PROC(GetCommandHeaderNV)
+GL3W_PROC(GetCompressedMultiTexImageEXT)
+GL3W_PROC(GetCompressedTexImage)
+GL3W_PROC(GetCompressedTextureImage)
+GL3W_PROC(GetCompressedTextureImageEXT)
+GL3W_PROC(GetCompressedTextureSubImage)
+GL3W_PROC(GetCoverageModulationTableNV)
+GL3W_PROC(GetDebugMessageLog)
+GL3W_PROC(GetDebugMessageLogARB)
+GL3W_PROC(GetDoubleIndexedvEXT)
+GL3W_PROC(GetDoublei_v)
+GL3W_PROC(GetDoublei_vEXT)
+GL3W_PROC(GetDoublev)
+GL3W_PROC(GetError)
+GL3W_PROC(GetFirstPerfQueryIdINTEL)
+GL3W_PROC(GetFloatIndexedvEXT)
+GL3W_PROC(GetFloati_v)
+GL3W_PROC(GetFloati_vEXT)
+GL3W_PROC(GetFloatv)
+GL3W_PROC(GetFragDataIndex)
+GL3W_PROC(GetFragDataLocation)
+GL3W_PROC(GetFramebufferAttachmentParameteriv)
+GL3W_PROC(GetFramebufferParameteriv)
+GL3W_PROC(GetFramebufferParameterivEXT)
+GL3W_PROC(GetGraphicsResetStatus)
+GL3W_PROC(GetGraphicsResetStatusARB)
+GL3W_PROC(GetImageHandleARB)
+GL3W_PROC(GetImageHandleNV)
+GL3W_PROC(GetInteger64i_v)
+GL3W_PROC(GetInteger64v)
+GL3W_PROC(GetIntegerIndexedvEXT)
+GL3W_PROC(GetIntegeri_v)
+GL3W_PROC(GetIntegerui64i_vNV)
+GL3W_PROC(GetIntegerui64vNV)
+GL3W_PROC(GetIntegerv)
+GL3W_PROC(GetInternalformatSampleivNV)
+GL3W_PROC(GetInternalformati64v)
+GL3W_PROC(GetInternalformativ)
+GL3W_PROC(GetMultiTexEnvfvEXT)
+GL3W_PROC(GetMultiTexEnvivEXT)
+GL3W_PROC(GetMultiTexGendvEXT)
+GL3W_PROC(GetMultiTexGenfvEXT)
+GL3W_PROC(GetMultiTexGenivEXT)
+GL3W_PROC(GetMultiTexImageEXT)
+GL3W_PROC(GetMultiTexLevelParameterfvEXT)
+GL3W_PROC(GetMultiTexLevelParameterivEXT)
+GL3W_PROC(GetMultiTexParameterIivEXT)
+GL3W_PROC(GetMultiTexParameterIuivEXT)
+GL3W_PROC(GetMultiTexParameterfvEXT)
+GL3W_PROC(GetMultiTexParameterivEXT)
+GL3W_PROC(GetMultisamplefv)
+GL3W_PROC(GetNamedBufferParameteri64v)
+GL3W_PROC(GetNamedBufferParameteriv)
+GL3W_PROC(GetNamedBufferParameterivEXT)
+GL3W_PROC(GetNamedBufferParameterui64vNV)
+GL3W_PROC(GetNamedBufferPointerv)
+GL3W_PROC(GetNamedBufferPointervEXT)
+GL3W_PROC(GetNamedBufferSubData)
+GL3W_PROC(GetNamedBufferSubDataEXT)
+GL3W_PROC(GetNamedFramebufferAttachmentParameteriv)
+GL3W_PROC(GetNamedFramebufferAttachmentParameterivEXT)
+GL3W_PROC(GetNamedFramebufferParameteriv)
+GL3W_PROC(GetNamedFramebufferParameterivEXT)
+GL3W_PROC(GetNamedProgramLocalParameterIivEXT)
+GL3W_PROC(GetNamedProgramLocalParameterIuivEXT)
+GL3W_PROC(GetNamedProgramLocalParameterdvEXT)
+GL3W_PROC(GetNamedProgramLocalParameterfvEXT)
+GL3W_PROC(GetNamedProgramStringEXT)
+GL3W_PROC(GetNamedProgramivEXT)
+GL3W_PROC(GetNamedRenderbufferParameteriv)
+GL3W_PROC(GetNamedRenderbufferParameterivEXT)
+GL3W_PROC(GetNamedStringARB)
+GL3W_PROC(GetNamedStringivARB)
+GL3W_PROC(GetNextPerfQueryIdINTEL)
+GL3W_PROC(GetObjectLabel)
+GL3W_PROC(GetObjectLabelEXT)
+GL3W_PROC(GetObjectPtrLabel)
+GL3W_PROC(GetPathCommandsNV)
+GL3W_PROC(GetPathCoordsNV)
+GL3W_PROC(GetPathDashArrayNV)
+GL3W_PROC(GetPathLengthNV)
+GL3W_PROC(GetPathMetricRangeNV)
+GL3W_PROC(GetPathMetricsNV)
+GL3W_PROC(GetPathParameterfvNV)
+GL3W_PROC(GetPathParameterivNV)
+GL3W_PROC(GetPathSpacingNV)
+GL3W_PROC(GetPerfCounterInfoINTEL)
+GL3W_PROC(GetPerfMonitorCounterDataAMD)
+GL3W_PROC(GetPerfMonitorCounterInfoAMD)
+GL3W_PROC(GetPerfMonitorCounterStringAMD)
+GL3W_PROC(GetPerfMonitorCountersAMD)
+GL3W_PROC(GetPerfMonitorGroupStringAMD)
+GL3W_PROC(GetPerfMonitorGroupsAMD)
+GL3W_PROC(GetPerfQueryDataINTEL)
+GL3W_PROC(GetPerfQueryIdByNameINTEL)
+GL3W_PROC(GetPerfQueryInfoINTEL)
+GL3W_PROC(GetPointerIndexedvEXT)
+GL3W_PROC(GetPointeri_vEXT)
+GL3W_PROC(GetPointerv)
+GL3W_PROC(GetProgramBinary)
+GL3W_PROC(GetProgramInfoLog)
+GL3W_PROC(GetProgramInterfaceiv)
+GL3W_PROC(GetProgramPipelineInfoLog)
+GL3W_PROC(GetProgramPipelineiv)
+GL3W_PROC(GetProgramResourceIndex)
+GL3W_PROC(GetProgramResourceLocation)
+GL3W_PROC(GetProgramResourceLocationIndex)
+GL3W_PROC(GetProgramResourceName)
+GL3W_PROC(GetProgramResourcefvNV)
+GL3W_PROC(GetProgramResourceiv)
+GL3W_PROC(GetProgramStageiv)
+GL3W_PROC(GetProgramiv)
+GL3W_PROC(GetQueryBufferObjecti64v)
+GL3W_PROC(GetQueryBufferObjectiv)
+GL3W_PROC(GetQueryBufferObjectui64v)
+GL3W_PROC(GetQueryBufferObjectuiv)
+GL3W_PROC(GetQueryIndexediv)
+GL3W_PROC(GetQueryObjecti64v)
+GL3W_PROC(GetQueryObjectiv)
+GL3W_PROC(GetQueryObjectui64v)
+GL3W_PROC(GetQueryObjectuiv)
+GL3W_PROC(GetQueryiv)
+GL3W_PROC(GetRenderbufferParameteriv)
+GL3W_PROC(GetSamplerParameterIiv)
+GL3W_PROC(GetSamplerParameterIuiv)
+GL3W_PROC(GetSamplerParameterfv)
+GL3W_PROC(GetSamplerParameteriv)
+GL3W_PROC(GetShaderInfoLog)
+GL3W_PROC(GetShaderPrecisionFormat)
+GL3W_PROC(GetShaderSource)
+GL3W_PROC(GetShaderiv)
+GL3W_PROC(GetStageIndexNV)
+GL3W_PROC(GetString)
+GL3W_PROC(GetStringi)
+GL3W_PROC(GetSubroutineIndex)
+GL3W_PROC(GetSubroutineUniformLocation)
+GL3W_PROC(GetSynciv)
+GL3W_PROC(GetTexImage)
+GL3W_PROC(GetTexLevelParameterfv)
+GL3W_PROC(GetTexLevelParameteriv)
+GL3W_PROC(GetTexParameterIiv)
+GL3W_PROC(GetTexParameterIuiv)
+GL3W_PROC(GetTexParameterfv)
+GL3W_PROC(GetTexParameteriv)
+GL3W_PROC(GetTextureHandleARB)
+GL3W_PROC(GetTextureHandleNV)
+GL3W_PROC(GetTextureImage)
+GL3W_PROC(GetTextureImageEXT)
+GL3W_PROC(GetTextureLevelParameterfv)
+GL3W_PROC(GetTextureLevelParameterfvEXT)
+GL3W_PROC(GetTextureLevelParameteriv)
+GL3W_PROC(GetTextureLevelParameterivEXT)
+GL3W_PROC(GetTextureParameterIiv)
+GL3W_PROC(GetTextureParameterIivEXT)
+GL3W_PROC(GetTextureParameterIuiv)
+GL3W_PROC(GetTextureParameterIuivEXT)
+GL3W_PROC(GetTextureParameterfv)
+GL3W_PROC(GetTextureParameterfvEXT)
+GL3W_PROC(GetTextureParameteriv)
+GL3W_PROC(GetTextureParameterivEXT)
+GL3W_PROC(GetTextureSamplerHandleARB)
+GL3W_PROC(GetTextureSamplerHandleNV)
+GL3W_PROC(GetTextureSubImage)
+GL3W_PROC(GetTransformFeedbackVarying)
+GL3W_PROC(GetTransformFeedbacki64_v)
+GL3W_PROC(GetTransformFeedbacki_v)
+GL3W_PROC(GetTransformFeedbackiv)
+GL3W_PROC(GetUniformBlockIndex)
+GL3W_PROC(GetUniformIndices)
+GL3W_PROC(GetUniformLocation)
+GL3W_PROC(GetUniformSubroutineuiv)
+GL3W_PROC(GetUniformdv)
+GL3W_PROC(GetUniformfv)
+GL3W_PROC(GetUniformi64vARB)
+GL3W_PROC(GetUniformi64vNV)
+GL3W_PROC(GetUniformiv)
+GL3W_PROC(GetUniformui64vARB)
+GL3W_PROC(GetUniformui64vNV)
+GL3W_PROC(GetUniformuiv)
+GL3W_PROC(GetVertexArrayIndexed64iv)
+GL3W_PROC(GetVertexArrayIndexediv)
+GL3W_PROC(GetVertexArrayIntegeri_vEXT)
+GL3W_PROC(GetVertexArrayIntegervEXT)
+GL3W_PROC(GetVertexArrayPointeri_vEXT)
+GL3W_PROC(GetVertexArrayPointervEXT)
+GL3W_PROC(GetVertexArrayiv)
+GL3W_PROC(GetVertexAttribIiv)
+GL3W_PROC(GetVertexAttribIuiv)
+GL3W_PROC(GetVertexAttribLdv)
+GL3W_PROC(GetVertexAttribLi64vNV)
+GL3W_PROC(GetVertexAttribLui64vARB)
+GL3W_PROC(GetVertexAttribLui64vNV)
+GL3W_PROC(GetVertexAttribPointerv)
+GL3W_PROC(GetVertexAttribdv)
+GL3W_PROC(GetVertexAttribfv)
+GL3W_PROC(GetVertexAttribiv)
+GL3W_PROC(GetVkProcAddrNV)
+GL3W_PROC(GetnCompressedTexImage)
+GL3W_PROC(GetnCompressedTexImageARB)
+GL3W_PROC(GetnTexImage)
+GL3W_PROC(GetnTexImageARB)
+GL3W_PROC(GetnUniformdv)
+GL3W_PROC(GetnUniformdvARB)
+GL3W_PROC(GetnUniformfv)
+GL3W_PROC(GetnUniformfvARB)
+GL3W_PROC(GetnUniformi64vARB)
+GL3W_PROC(GetnUniformiv)
+GL3W_PROC(GetnUniformivARB)
+GL3W_PROC(GetnUniformui64vARB)
+GL3W_PROC(GetnUniformuiv)
+GL3W_PROC(GetnUniformuivARB)
+GL3W_PROC(Hint)
+GL3W_PROC(IndexFormatNV)
+GL3W_PROC(InsertEventMarkerEXT)
+GL3W_PROC(InterpolatePathsNV)
+GL3W_PROC(InvalidateBufferData)
+GL3W_PROC(InvalidateBufferSubData)
+GL3W_PROC(InvalidateFramebuffer)
+GL3W_PROC(InvalidateNamedFramebufferData)
+GL3W_PROC(InvalidateNamedFramebufferSubData)
+GL3W_PROC(InvalidateSubFramebuffer)
+GL3W_PROC(InvalidateTexImage)
+GL3W_PROC(InvalidateTexSubImage)
+GL3W_PROC(IsBuffer)
+GL3W_PROC(IsBufferResidentNV)
+GL3W_PROC(IsCommandListNV)
+GL3W_PROC(IsEnabled)
+GL3W_PROC(IsEnabledIndexedEXT)
+GL3W_PROC(IsEnabledi)
+GL3W_PROC(IsFramebuffer)
+GL3W_PROC(IsImageHandleResidentARB)
+GL3W_PROC(IsImageHandleResidentNV)
+GL3W_PROC(IsNamedBufferResidentNV)
+GL3W_PROC(IsNamedStringARB)
+GL3W_PROC(IsPathNV)
+GL3W_PROC(IsPointInFillPathNV)
+GL3W_PROC(IsPointInStrokePathNV)
+GL3W_PROC(IsProgram)
+GL3W_PROC(IsProgramPipeline)
+GL3W_PROC(IsQuery)
+GL3W_PROC(IsRenderbuffer)
+GL3W_PROC(IsSampler)
+GL3W_PROC(IsShader)
+GL3W_PROC(IsStateNV)
+GL3W_PROC(IsSync)
+GL3W_PROC(IsTexture)
+GL3W_PROC(IsTextureHandleResidentARB)
+GL3W_PROC(IsTextureHandleResidentNV)
+GL3W_PROC(IsTransformFeedback)
+GL3W_PROC(IsVertexArray)
+GL3W_PROC(LabelObjectEXT)
+GL3W_PROC(LineWidth)
+GL3W_PROC(LinkProgram)
+GL3W_PROC(ListDrawCommandsStatesClientNV)
+GL3W_PROC(LogicOp)
+GL3W_PROC(MakeBufferNonResidentNV)
+GL3W_PROC(MakeBufferResidentNV)
+GL3W_PROC(MakeImageHandleNonResidentARB)
+GL3W_PROC(MakeImageHandleNonResidentNV)
+GL3W_PROC(MakeImageHandleResidentARB)
+GL3W_PROC(MakeImageHandleResidentNV)
+GL3W_PROC(MakeNamedBufferNonResidentNV)
+GL3W_PROC(MakeNamedBufferResidentNV)
+GL3W_PROC(MakeTextureHandleNonResidentARB)
+GL3W_PROC(MakeTextureHandleNonResidentNV)
+GL3W_PROC(MakeTextureHandleResidentARB)
+GL3W_PROC(MakeTextureHandleResidentNV)
+GL3W_PROC(MapBuffer)
+GL3W_PROC(MapBufferRange)
+GL3W_PROC(MapNamedBuffer)
+GL3W_PROC(MapNamedBufferEXT)
+GL3W_PROC(MapNamedBufferRange)
+GL3W_PROC(MapNamedBufferRangeEXT)
+GL3W_PROC(MatrixFrustumEXT)
+GL3W_PROC(MatrixLoad3x2fNV)
+GL3W_PROC(MatrixLoad3x3fNV)
+GL3W_PROC(MatrixLoadIdentityEXT)
+GL3W_PROC(MatrixLoadTranspose3x3fNV)
+GL3W_PROC(MatrixLoadTransposedEXT)
+GL3W_PROC(MatrixLoadTransposefEXT)
+GL3W_PROC(MatrixLoaddEXT)
+GL3W_PROC(MatrixLoadfEXT)
+GL3W_PROC(MatrixMult3x2fNV)
+GL3W_PROC(MatrixMult3x3fNV)
+GL3W_PROC(MatrixMultTranspose3x3fNV)
+GL3W_PROC(MatrixMultTransposedEXT)
+GL3W_PROC(MatrixMultTransposefEXT)
+GL3W_PROC(MatrixMultdEXT)
+GL3W_PROC(MatrixMultfEXT)
+GL3W_PROC(MatrixOrthoEXT)
+GL3W_PROC(MatrixPopEXT)
+GL3W_PROC(MatrixPushEXT)
+GL3W_PROC(MatrixRotatedEXT)
+GL3W_PROC(MatrixRotatefEXT)
+GL3W_PROC(MatrixScaledEXT)
+GL3W_PROC(MatrixScalefEXT)
+GL3W_PROC(MatrixTranslatedEXT)
+GL3W_PROC(MatrixTranslatefEXT)
+GL3W_PROC(MaxShaderCompilerThreadsARB)
+GL3W_PROC(MaxShaderCompilerThreadsKHR)
+GL3W_PROC(MemoryBarrier)
+GL3W_PROC(MemoryBarrierByRegion)
+GL3W_PROC(MinSampleShading)
+GL3W_PROC(MinSampleShadingARB)
+GL3W_PROC(MultiDrawArrays)
+GL3W_PROC(MultiDrawArraysIndirect)
+GL3W_PROC(MultiDrawArraysIndirectBindlessCountNV)
+GL3W_PROC(MultiDrawArraysIndirectBindlessNV)
+GL3W_PROC(MultiDrawArraysIndirectCount)
+GL3W_PROC(MultiDrawArraysIndirectCountARB)
+GL3W_PROC(MultiDrawElements)
+GL3W_PROC(MultiDrawElementsBaseVertex)
+GL3W_PROC(MultiDrawElementsIndirect)
+GL3W_PROC(MultiDrawElementsIndirectBindlessCountNV)
+GL3W_PROC(MultiDrawElementsIndirectBindlessNV)
+GL3W_PROC(MultiDrawElementsIndirectCount)
+GL3W_PROC(MultiDrawElementsIndirectCountARB)
+GL3W_PROC(MultiTexBufferEXT)
+GL3W_PROC(MultiTexCoordPointerEXT)
+GL3W_PROC(MultiTexEnvfEXT)
+GL3W_PROC(MultiTexEnvfvEXT)
+GL3W_PROC(MultiTexEnviEXT)
+GL3W_PROC(MultiTexEnvivEXT)
+GL3W_PROC(MultiTexGendEXT)
+GL3W_PROC(MultiTexGendvEXT)
+GL3W_PROC(MultiTexGenfEXT)
+GL3W_PROC(MultiTexGenfvEXT)
+GL3W_PROC(MultiTexGeniEXT)
+GL3W_PROC(MultiTexGenivEXT)
+GL3W_PROC(MultiTexImage1DEXT)
+GL3W_PROC(MultiTexImage2DEXT)
+GL3W_PROC(MultiTexImage3DEXT)
+GL3W_PROC(MultiTexParameterIivEXT)
+GL3W_PROC(MultiTexParameterIuivEXT)
+GL3W_PROC(MultiTexParameterfEXT)
+GL3W_PROC(MultiTexParameterfvEXT)
+GL3W_PROC(MultiTexParameteriEXT)
+GL3W_PROC(MultiTexParameterivEXT)
+GL3W_PROC(MultiTexRenderbufferEXT)
+GL3W_PROC(MultiTexSubImage1DEXT)
+GL3W_PROC(MultiTexSubImage2DEXT)
+GL3W_PROC(MultiTexSubImage3DEXT)
+GL3W_PROC(NamedBufferData)
+GL3W_PROC(NamedBufferDataEXT)
+GL3W_PROC(NamedBufferPageCommitmentARB)
+GL3W_PROC(NamedBufferPageCommitmentEXT)
+GL3W_PROC(NamedBufferStorage)
+GL3W_PROC(NamedBufferStorageEXT)
+GL3W_PROC(NamedBufferSubData)
+GL3W_PROC(NamedBufferSubDataEXT)
+GL3W_PROC(NamedCopyBufferSubDataEXT)
+GL3W_PROC(NamedFramebufferDrawBuffer)
+GL3W_PROC(NamedFramebufferDrawBuffers)
+GL3W_PROC(NamedFramebufferParameteri)
+GL3W_PROC(NamedFramebufferParameteriEXT)
+GL3W_PROC(NamedFramebufferReadBuffer)
+GL3W_PROC(NamedFramebufferRenderbuffer)
+GL3W_PROC(NamedFramebufferRenderbufferEXT)
+GL3W_PROC(NamedFramebufferSampleLocationsfvARB)
+GL3W_PROC(NamedFramebufferSampleLocationsfvNV)
+GL3W_PROC(NamedFramebufferTexture)
+GL3W_PROC(NamedFramebufferTexture1DEXT)
+GL3W_PROC(NamedFramebufferTexture2DEXT)
+GL3W_PROC(NamedFramebufferTexture3DEXT)
+GL3W_PROC(NamedFramebufferTextureEXT)
+GL3W_PROC(NamedFramebufferTextureFaceEXT)
+GL3W_PROC(NamedFramebufferTextureLayer)
+GL3W_PROC(NamedFramebufferTextureLayerEXT)
+GL3W_PROC(NamedProgramLocalParameter4dEXT)
+GL3W_PROC(NamedProgramLocalParameter4dvEXT)
+GL3W_PROC(NamedProgramLocalParameter4fEXT)
+GL3W_PROC(NamedProgramLocalParameter4fvEXT)
+GL3W_PROC(NamedProgramLocalParameterI4iEXT)
+GL3W_PROC(NamedProgramLocalParameterI4ivEXT)
+GL3W_PROC(NamedProgramLocalParameterI4uiEXT)
+GL3W_PROC(NamedProgramLocalParameterI4uivEXT)
+GL3W_PROC(NamedProgramLocalParameters4fvEXT)
+GL3W_PROC(NamedProgramLocalParametersI4ivEXT)
+GL3W_PROC(NamedProgramLocalParametersI4uivEXT)
+GL3W_PROC(NamedProgramStringEXT)
+GL3W_PROC(NamedRenderbufferStorage)
+GL3W_PROC(NamedRenderbufferStorageEXT)
+GL3W_PROC(NamedRenderbufferStorageMultisample)
+GL3W_PROC(NamedRenderbufferStorageMultisampleCoverageEXT)
+GL3W_PROC(NamedRenderbufferStorageMultisampleEXT)
+GL3W_PROC(NamedStringARB)
+GL3W_PROC(NormalFormatNV)
+GL3W_PROC(ObjectLabel)
+GL3W_PROC(ObjectPtrLabel)
+GL3W_PROC(PatchParameterfv)
+GL3W_PROC(PatchParameteri)
+GL3W_PROC(PathCommandsNV)
+GL3W_PROC(PathCoordsNV)
+GL3W_PROC(PathCoverDepthFuncNV)
+GL3W_PROC(PathDashArrayNV)
+GL3W_PROC(PathGlyphIndexArrayNV)
+GL3W_PROC(PathGlyphIndexRangeNV)
+GL3W_PROC(PathGlyphRangeNV)
+GL3W_PROC(PathGlyphsNV)
+GL3W_PROC(PathMemoryGlyphIndexArrayNV)
+GL3W_PROC(PathParameterfNV)
+GL3W_PROC(PathParameterfvNV)
+GL3W_PROC(PathParameteriNV)
+GL3W_PROC(PathParameterivNV)
+GL3W_PROC(PathStencilDepthOffsetNV)
+GL3W_PROC(PathStencilFuncNV)
+GL3W_PROC(PathStringNV)
+GL3W_PROC(PathSubCommandsNV)
+GL3W_PROC(PathSubCoordsNV)
+GL3W_PROC(PauseTransformFeedback)
+GL3W_PROC(PixelStoref)
+GL3W_PROC(PixelStorei)
+GL3W_PROC(PointAlongPathNV)
+GL3W_PROC(PointParameterf)
+GL3W_PROC(PointParameterfv)
+GL3W_PROC(PointParameteri)
+GL3W_PROC(PointParameteriv)
+GL3W_PROC(PointSize)
+GL3W_PROC(PolygonMode)
+GL3W_PROC(PolygonOffset)
+GL3W_PROC(PolygonOffsetClamp)
+GL3W_PROC(PolygonOffsetClampEXT)
+GL3W_PROC(PopDebugGroup)
+GL3W_PROC(PopGroupMarkerEXT)
+GL3W_PROC(PrimitiveBoundingBoxARB)
+GL3W_PROC(PrimitiveRestartIndex)
+GL3W_PROC(ProgramBinary)
+GL3W_PROC(ProgramParameteri)
+GL3W_PROC(ProgramParameteriARB)
+GL3W_PROC(ProgramPathFragmentInputGenNV)
+GL3W_PROC(ProgramUniform1d)
+GL3W_PROC(ProgramUniform1dEXT)
+GL3W_PROC(ProgramUniform1dv)
+GL3W_PROC(ProgramUniform1dvEXT)
+GL3W_PROC(ProgramUniform1f)
+GL3W_PROC(ProgramUniform1fEXT)
+GL3W_PROC(ProgramUniform1fv)
+GL3W_PROC(ProgramUniform1fvEXT)
+GL3W_PROC(ProgramUniform1i)
+GL3W_PROC(ProgramUniform1i64ARB)
+GL3W_PROC(ProgramUniform1i64NV)
+GL3W_PROC(ProgramUniform1i64vARB)
+GL3W_PROC(ProgramUniform1i64vNV)
+GL3W_PROC(ProgramUniform1iEXT)
+GL3W_PROC(ProgramUniform1iv)
+GL3W_PROC(ProgramUniform1ivEXT)
+GL3W_PROC(ProgramUniform1ui)
+GL3W_PROC(ProgramUniform1ui64ARB)
+GL3W_PROC(ProgramUniform1ui64NV)
+GL3W_PROC(ProgramUniform1ui64vARB)
+GL3W_PROC(ProgramUniform1ui64vNV)
+GL3W_PROC(ProgramUniform1uiEXT)
+GL3W_PROC(ProgramUniform1uiv)
+GL3W_PROC(ProgramUniform1uivEXT)
+GL3W_PROC(ProgramUniform2d)
+GL3W_PROC(ProgramUniform2dEXT)
+GL3W_PROC(ProgramUniform2dv)
+GL3W_PROC(ProgramUniform2dvEXT)
+GL3W_PROC(ProgramUniform2f)
+GL3W_PROC(ProgramUniform2fEXT)
+GL3W_PROC(ProgramUniform2fv)
+GL3W_PROC(ProgramUniform2fvEXT)
+GL3W_PROC(ProgramUniform2i)
+GL3W_PROC(ProgramUniform2i64ARB)
+GL3W_PROC(ProgramUniform2i64NV)
+GL3W_PROC(ProgramUniform2i64vARB)
+GL3W_PROC(ProgramUniform2i64vNV)
+GL3W_PROC(ProgramUniform2iEXT)
+GL3W_PROC(ProgramUniform2iv)
+GL3W_PROC(ProgramUniform2ivEXT)
+GL3W_PROC(ProgramUniform2ui)
+GL3W_PROC(ProgramUniform2ui64ARB)
+GL3W_PROC(ProgramUniform2ui64NV)
+GL3W_PROC(ProgramUniform2ui64vARB)
+GL3W_PROC(ProgramUniform2ui64vNV)
+GL3W_PROC(ProgramUniform2uiEXT)
+GL3W_PROC(ProgramUniform2uiv)
+GL3W_PROC(ProgramUniform2uivEXT)
+GL3W_PROC(ProgramUniform3d)
+GL3W_PROC(ProgramUniform3dEXT)
+GL3W_PROC(ProgramUniform3dv)
+GL3W_PROC(ProgramUniform3dvEXT)
+GL3W_PROC(ProgramUniform3f)
+GL3W_PROC(ProgramUniform3fEXT)
+GL3W_PROC(ProgramUniform3fv)
+GL3W_PROC(ProgramUniform3fvEXT)
+GL3W_PROC(ProgramUniform3i)
+GL3W_PROC(ProgramUniform3i64ARB)
+GL3W_PROC(ProgramUniform3i64NV)
+GL3W_PROC(ProgramUniform3i64vARB)
+GL3W_PROC(ProgramUniform3i64vNV)
+GL3W_PROC(ProgramUniform3iEXT)
+GL3W_PROC(ProgramUniform3iv)
+GL3W_PROC(ProgramUniform3ivEXT)
+GL3W_PROC(ProgramUniform3ui)
+GL3W_PROC(ProgramUniform3ui64ARB)
+GL3W_PROC(ProgramUniform3ui64NV)
+GL3W_PROC(ProgramUniform3ui64vARB)
+GL3W_PROC(ProgramUniform3ui64vNV)
+GL3W_PROC(ProgramUniform3uiEXT)
+GL3W_PROC(ProgramUniform3uiv)
+GL3W_PROC(ProgramUniform3uivEXT)
+GL3W_PROC(ProgramUniform4d)
+GL3W_PROC(ProgramUniform4dEXT)
+GL3W_PROC(ProgramUniform4dv)
+GL3W_PROC(ProgramUniform4dvEXT)
+GL3W_PROC(ProgramUniform4f)
+GL3W_PROC(ProgramUniform4fEXT)
+GL3W_PROC(ProgramUniform4fv)
+GL3W_PROC(ProgramUniform4fvEXT)
+GL3W_PROC(ProgramUniform4i)
+GL3W_PROC(ProgramUniform4i64ARB)
+GL3W_PROC(ProgramUniform4i64NV)
+GL3W_PROC(ProgramUniform4i64vARB)
+GL3W_PROC(ProgramUniform4i64vNV)
+GL3W_PROC(ProgramUniform4iEXT)
+GL3W_PROC(ProgramUniform4iv)
+GL3W_PROC(ProgramUniform4ivEXT)
+GL3W_PROC(ProgramUniform4ui)
+GL3W_PROC(ProgramUniform4ui64ARB)
+GL3W_PROC(ProgramUniform4ui64NV)
+GL3W_PROC(ProgramUniform4ui64vARB)
+GL3W_PROC(ProgramUniform4ui64vNV)
+GL3W_PROC(ProgramUniform4uiEXT)
+GL3W_PROC(ProgramUniform4uiv)
+GL3W_PROC(ProgramUniform4uivEXT)
+GL3W_PROC(ProgramUniformHandleui64ARB)
+GL3W_PROC(ProgramUniformHandleui64NV)
+GL3W_PROC(ProgramUniformHandleui64vARB)
+GL3W_PROC(ProgramUniformHandleui64vNV)
+GL3W_PROC(ProgramUniformMatrix2dv)
+GL3W_PROC(ProgramUniformMatrix2dvEXT)
+GL3W_PROC(ProgramUniformMatrix2fv)
+GL3W_PROC(ProgramUniformMatrix2fvEXT)
+GL3W_PROC(ProgramUniformMatrix2x3dv)
+GL3W_PROC(ProgramUniformMatrix2x3dvEXT)
+GL3W_PROC(ProgramUniformMatrix2x3fv)
+GL3W_PROC(ProgramUniformMatrix2x3fvEXT)
+GL3W_PROC(ProgramUniformMatrix2x4dv)
+GL3W_PROC(ProgramUniformMatrix2x4dvEXT)
+GL3W_PROC(ProgramUniformMatrix2x4fv)
+GL3W_PROC(ProgramUniformMatrix2x4fvEXT)
+GL3W_PROC(ProgramUniformMatrix3dv)
+GL3W_PROC(ProgramUniformMatrix3dvEXT)
+GL3W_PROC(ProgramUniformMatrix3fv)
+GL3W_PROC(ProgramUniformMatrix3fvEXT)
+GL3W_PROC(ProgramUniformMatrix3x2dv)
+GL3W_PROC(ProgramUniformMatrix3x2dvEXT)
+GL3W_PROC(ProgramUniformMatrix3x2fv)
+GL3W_PROC(ProgramUniformMatrix3x2fvEXT)
+GL3W_PROC(ProgramUniformMatrix3x4dv)
+GL3W_PROC(ProgramUniformMatrix3x4dvEXT)
+GL3W_PROC(ProgramUniformMatrix3x4fv)
+GL3W_PROC(ProgramUniformMatrix3x4fvEXT)
+GL3W_PROC(ProgramUniformMatrix4dv)
+GL3W_PROC(ProgramUniformMatrix4dvEXT)
+GL3W_PROC(ProgramUniformMatrix4fv)
+GL3W_PROC(ProgramUniformMatrix4fvEXT)
+GL3W_PROC(ProgramUniformMatrix4x2dv)
+GL3W_PROC(ProgramUniformMatrix4x2dvEXT)
+GL3W_PROC(ProgramUniformMatrix4x2fv)
+GL3W_PROC(ProgramUniformMatrix4x2fvEXT)
+GL3W_PROC(ProgramUniformMatrix4x3dv)
+GL3W_PROC(ProgramUniformMatrix4x3dvEXT)
+GL3W_PROC(ProgramUniformMatrix4x3fv)
+GL3W_PROC(ProgramUniformMatrix4x3fvEXT)
+GL3W_PROC(ProgramUniformui64NV)
+GL3W_PROC(ProgramUniformui64vNV)
+GL3W_PROC(ProvokingVertex)
+GL3W_PROC(PushClientAttribDefaultEXT)
+GL3W_PROC(PushDebugGroup)
+GL3W_PROC(PushGroupMarkerEXT)
+GL3W_PROC(QueryCounter)
+GL3W_PROC(RasterSamplesEXT)
+GL3W_PROC(ReadBuffer)
+GL3W_PROC(ReadPixels)
+GL3W_PROC(ReadnPixels)
+GL3W_PROC(ReadnPixelsARB)
+GL3W_PROC(ReleaseShaderCompiler)
+GL3W_PROC(RenderbufferStorage)
+GL3W_PROC(RenderbufferStorageMultisample)
+GL3W_PROC(RenderbufferStorageMultisampleCoverageNV)
+GL3W_PROC(ResolveDepthValuesNV)
+GL3W_PROC(ResumeTransformFeedback)
+GL3W_PROC(SampleCoverage)
+GL3W_PROC(SampleMaski)
+GL3W_PROC(SamplerParameterIiv)
+GL3W_PROC(SamplerParameterIuiv)
+GL3W_PROC(SamplerParameterf)
+GL3W_PROC(SamplerParameterfv)
+GL3W_PROC(SamplerParameteri)
+GL3W_PROC(SamplerParameteriv)
+GL3W_PROC(Scissor)
+GL3W_PROC(ScissorArrayv)
+GL3W_PROC(ScissorIndexed)
+GL3W_PROC(ScissorIndexedv)
+GL3W_PROC(SecondaryColorFormatNV)
+GL3W_PROC(SelectPerfMonitorCountersAMD)
+GL3W_PROC(ShaderBinary)
+GL3W_PROC(ShaderSource)
+GL3W_PROC(ShaderStorageBlockBinding)
+GL3W_PROC(SignalVkFenceNV)
+GL3W_PROC(SignalVkSemaphoreNV)
+GL3W_PROC(SpecializeShader)
+GL3W_PROC(SpecializeShaderARB)
+GL3W_PROC(StateCaptureNV)
+GL3W_PROC(StencilFillPathInstancedNV)
+GL3W_PROC(StencilFillPathNV)
+GL3W_PROC(StencilFunc)
+GL3W_PROC(StencilFuncSeparate)
+GL3W_PROC(StencilMask)
+GL3W_PROC(StencilMaskSeparate)
+GL3W_PROC(StencilOp)
+GL3W_PROC(StencilOpSeparate)
+GL3W_PROC(StencilStrokePathInstancedNV)
+GL3W_PROC(StencilStrokePathNV)
+GL3W_PROC(StencilThenCoverFillPathInstancedNV)
+GL3W_PROC(StencilThenCoverFillPathNV)
+GL3W_PROC(StencilThenCoverStrokePathInstancedNV)
+GL3W_PROC(StencilThenCoverStrokePathNV)
+GL3W_PROC(SubpixelPrecisionBiasNV)
+GL3W_PROC(TexBuffer)
+GL3W_PROC(TexBufferARB)
+GL3W_PROC(TexBufferRange)
+GL3W_PROC(TexCoordFormatNV)
+GL3W_PROC(TexImage1D)
+GL3W_PROC(TexImage2D)
+GL3W_PROC(TexImage2DMultisample)
+GL3W_PROC(TexImage3D)
+GL3W_PROC(TexImage3DMultisample)
+GL3W_PROC(TexPageCommitmentARB)
+GL3W_PROC(TexParameterIiv)
+GL3W_PROC(TexParameterIuiv)
+GL3W_PROC(TexParameterf)
+GL3W_PROC(TexParameterfv)
+GL3W_PROC(TexParameteri)
+GL3W_PROC(TexParameteriv)
+GL3W_PROC(TexStorage1D)
+GL3W_PROC(TexStorage2D)
+GL3W_PROC(TexStorage2DMultisample)
+GL3W_PROC(TexStorage3D)
+GL3W_PROC(TexStorage3DMultisample)
+GL3W_PROC(TexSubImage1D)
+GL3W_PROC(TexSubImage2D)
+GL3W_PROC(TexSubImage3D)
+GL3W_PROC(TextureBarrier)
+GL3W_PROC(TextureBarrierNV)
+GL3W_PROC(TextureBuffer)
+GL3W_PROC(TextureBufferEXT)
+GL3W_PROC(TextureBufferRange)
+GL3W_PROC(TextureBufferRangeEXT)
+GL3W_PROC(TextureImage1DEXT)
+GL3W_PROC(TextureImage2DEXT)
+GL3W_PROC(TextureImage3DEXT)
+GL3W_PROC(TexturePageCommitmentEXT)
+GL3W_PROC(TextureParameterIiv)
+GL3W_PROC(TextureParameterIivEXT)
+GL3W_PROC(TextureParameterIuiv)
+GL3W_PROC(TextureParameterIuivEXT)
+GL3W_PROC(TextureParameterf)
+GL3W_PROC(TextureParameterfEXT)
+GL3W_PROC(TextureParameterfv)
+GL3W_PROC(TextureParameterfvEXT)
+GL3W_PROC(TextureParameteri)
+GL3W_PROC(TextureParameteriEXT)
+GL3W_PROC(TextureParameteriv)
+GL3W_PROC(TextureParameterivEXT)
+GL3W_PROC(TextureRenderbufferEXT)
+GL3W_PROC(TextureStorage1D)
+GL3W_PROC(TextureStorage1DEXT)
+GL3W_PROC(TextureStorage2D)
+GL3W_PROC(TextureStorage2DEXT)
+GL3W_PROC(TextureStorage2DMultisample)
+GL3W_PROC(TextureStorage2DMultisampleEXT)
+GL3W_PROC(TextureStorage3D)
+GL3W_PROC(TextureStorage3DEXT)
+GL3W_PROC(TextureStorage3DMultisample)
+GL3W_PROC(TextureStorage3DMultisampleEXT)
+GL3W_PROC(TextureSubImage1D)
+GL3W_PROC(TextureSubImage1DEXT)
+GL3W_PROC(TextureSubImage2D)
+GL3W_PROC(TextureSubImage2DEXT)
+GL3W_PROC(TextureSubImage3D)
+GL3W_PROC(TextureSubImage3DEXT)
+GL3W_PROC(TextureView)
+GL3W_PROC(TransformFeedbackBufferBase)
+GL3W_PROC(TransformFeedbackBufferRange)
+GL3W_PROC(TransformFeedbackVaryings)
+GL3W_PROC(TransformPathNV)
+GL3W_PROC(Uniform1d)
+GL3W_PROC(Uniform1dv)
+GL3W_PROC(Uniform1f)
+GL3W_PROC(Uniform1fv)
+GL3W_PROC(Uniform1i)
+GL3W_PROC(Uniform1i64ARB)
+GL3W_PROC(Uniform1i64NV)
+GL3W_PROC(Uniform1i64vARB)
+GL3W_PROC(Uniform1i64vNV)
+GL3W_PROC(Uniform1iv)
+GL3W_PROC(Uniform1ui)
+GL3W_PROC(Uniform1ui64ARB)
+GL3W_PROC(Uniform1ui64NV)
+GL3W_PROC(Uniform1ui64vARB)
+GL3W_PROC(Uniform1ui64vNV)
+GL3W_PROC(Uniform1uiv)
+GL3W_PROC(Uniform2d)
+GL3W_PROC(Uniform2dv)
+GL3W_PROC(Uniform2f)
+GL3W_PROC(Uniform2fv)
+GL3W_PROC(Uniform2i)
+GL3W_PROC(Uniform2i64ARB)
+GL3W_PROC(Uniform2i64NV)
+GL3W_PROC(Uniform2i64vARB)
+GL3W_PROC(Uniform2i64vNV)
+GL3W_PROC(Uniform2iv)
+GL3W_PROC(Uniform2ui)
+GL3W_PROC(Uniform2ui64ARB)
+GL3W_PROC(Uniform2ui64NV)
+GL3W_PROC(Uniform2ui64vARB)
+GL3W_PROC(Uniform2ui64vNV)
+GL3W_PROC(Uniform2uiv)
+GL3W_PROC(Uniform3d)
+GL3W_PROC(Uniform3dv)
+GL3W_PROC(Uniform3f)
+GL3W_PROC(Uniform3fv)
+GL3W_PROC(Uniform3i)
+GL3W_PROC(Uniform3i64ARB)
+GL3W_PROC(Uniform3i64NV)
+GL3W_PROC(Uniform3i64vARB)
+GL3W_PROC(Uniform3i64vNV)
+GL3W_PROC(Uniform3iv)
+GL3W_PROC(Uniform3ui)
+GL3W_PROC(Uniform3ui64ARB)
+GL3W_PROC(Uniform3ui64NV)
+GL3W_PROC(Uniform3ui64vARB)
+GL3W_PROC(Uniform3ui64vNV)
+GL3W_PROC(Uniform3uiv)
+GL3W_PROC(Uniform4d)
+GL3W_PROC(Uniform4dv)
+GL3W_PROC(Uniform4f)
+GL3W_PROC(Uniform4fv)
+GL3W_PROC(Uniform4i)
+GL3W_PROC(Uniform4i64ARB)
+GL3W_PROC(Uniform4i64NV)
+GL3W_PROC(Uniform4i64vARB)
+GL3W_PROC(Uniform4i64vNV)
+GL3W_PROC(Uniform4iv)
+GL3W_PROC(Uniform4ui)
+GL3W_PROC(Uniform4ui64ARB)
+GL3W_PROC(Uniform4ui64NV)
+GL3W_PROC(Uniform4ui64vARB)
+GL3W_PROC(Uniform4ui64vNV)
+GL3W_PROC(Uniform4uiv)
+GL3W_PROC(UniformBlockBinding)
+GL3W_PROC(UniformHandleui64ARB)
+GL3W_PROC(UniformHandleui64NV)
+GL3W_PROC(UniformHandleui64vARB)
+GL3W_PROC(UniformHandleui64vNV)
+GL3W_PROC(UniformMatrix2dv)
+GL3W_PROC(UniformMatrix2fv)
+GL3W_PROC(UniformMatrix2x3dv)
+GL3W_PROC(UniformMatrix2x3fv)
+GL3W_PROC(UniformMatrix2x4dv)
+GL3W_PROC(UniformMatrix2x4fv)
+GL3W_PROC(UniformMatrix3dv)
+GL3W_PROC(UniformMatrix3fv)
+GL3W_PROC(UniformMatrix3x2dv)
+GL3W_PROC(UniformMatrix3x2fv)
+GL3W_PROC(UniformMatrix3x4dv)
+GL3W_PROC(UniformMatrix3x4fv)
+GL3W_PROC(UniformMatrix4dv)
+GL3W_PROC(UniformMatrix4fv)
+GL3W_PROC(UniformMatrix4x2dv)
+GL3W_PROC(UniformMatrix4x2fv)
+GL3W_PROC(UniformMatrix4x3dv)
+GL3W_PROC(UniformMatrix4x3fv)
+GL3W_PROC(UniformSubroutinesuiv)
+GL3W_PROC(Uniformui64NV)
+GL3W_PROC(Uniformui64vNV)
+GL3W_PROC(UnmapBuffer)
+GL3W_PROC(UnmapNamedBuffer)
+GL3W_PROC(UnmapNamedBufferEXT)
+GL3W_PROC(UseProgram)
+GL3W_PROC(UseProgramStages)
+GL3W_PROC(UseShaderProgramEXT)
+GL3W_PROC(ValidateProgram)
+GL3W_PROC(ValidateProgramPipeline)
+GL3W_PROC(VertexArrayAttribBinding)
+GL3W_PROC(VertexArrayAttribFormat)
+GL3W_PROC(VertexArrayAttribIFormat)
+GL3W_PROC(VertexArrayAttribLFormat)
+GL3W_PROC(VertexArrayBindVertexBufferEXT)
+GL3W_PROC(VertexArrayBindingDivisor)
+GL3W_PROC(VertexArrayColorOffsetEXT)
+GL3W_PROC(VertexArrayEdgeFlagOffsetEXT)
+GL3W_PROC(VertexArrayElementBuffer)
+GL3W_PROC(VertexArrayFogCoordOffsetEXT)
+GL3W_PROC(VertexArrayIndexOffsetEXT)
+GL3W_PROC(VertexArrayMultiTexCoordOffsetEXT)
+GL3W_PROC(VertexArrayNormalOffsetEXT)
+GL3W_PROC(VertexArraySecondaryColorOffsetEXT)
+GL3W_PROC(VertexArrayTexCoordOffsetEXT)
+GL3W_PROC(VertexArrayVertexAttribBindingEXT)
+GL3W_PROC(VertexArrayVertexAttribDivisorEXT)
+GL3W_PROC(VertexArrayVertexAttribFormatEXT)
+GL3W_PROC(VertexArrayVertexAttribIFormatEXT)
+GL3W_PROC(VertexArrayVertexAttribIOffsetEXT)
+GL3W_PROC(VertexArrayVertexAttribLFormatEXT)
+GL3W_PROC(VertexArrayVertexAttribLOffsetEXT)
+GL3W_PROC(VertexArrayVertexAttribOffsetEXT)
+GL3W_PROC(VertexArrayVertexBindingDivisorEXT)
+GL3W_PROC(VertexArrayVertexBuffer)
+GL3W_PROC(VertexArrayVertexBuffers)
+GL3W_PROC(VertexArrayVertexOffsetEXT)
+GL3W_PROC(VertexAttrib1d)
+GL3W_PROC(VertexAttrib1dv)
+GL3W_PROC(VertexAttrib1f)
+GL3W_PROC(VertexAttrib1fv)
+GL3W_PROC(VertexAttrib1s)
+GL3W_PROC(VertexAttrib1sv)
+GL3W_PROC(VertexAttrib2d)
+GL3W_PROC(VertexAttrib2dv)
+GL3W_PROC(VertexAttrib2f)
+GL3W_PROC(VertexAttrib2fv)
+GL3W_PROC(VertexAttrib2s)
+GL3W_PROC(VertexAttrib2sv)
+GL3W_PROC(VertexAttrib3d)
+GL3W_PROC(VertexAttrib3dv)
+GL3W_PROC(VertexAttrib3f)
+GL3W_PROC(VertexAttrib3fv)
+GL3W_PROC(VertexAttrib3s)
+GL3W_PROC(VertexAttrib3sv)
+GL3W_PROC(VertexAttrib4Nbv)
+GL3W_PROC(VertexAttrib4Niv)
+GL3W_PROC(VertexAttrib4Nsv)
+GL3W_PROC(VertexAttrib4Nub)
+GL3W_PROC(VertexAttrib4Nubv)
+GL3W_PROC(VertexAttrib4Nuiv)
+GL3W_PROC(VertexAttrib4Nusv)
+GL3W_PROC(VertexAttrib4bv)
+GL3W_PROC(VertexAttrib4d)
+GL3W_PROC(VertexAttrib4dv)
+GL3W_PROC(VertexAttrib4f)
+GL3W_PROC(VertexAttrib4fv)
+GL3W_PROC(VertexAttrib4iv)
+GL3W_PROC(VertexAttrib4s)
+GL3W_PROC(VertexAttrib4sv)
+GL3W_PROC(VertexAttrib4ubv)
+GL3W_PROC(VertexAttrib4uiv)
+GL3W_PROC(VertexAttrib4usv)
+GL3W_PROC(VertexAttribBinding)
+GL3W_PROC(VertexAttribDivisor)
+GL3W_PROC(VertexAttribDivisorARB)
+GL3W_PROC(VertexAttribFormat)
+GL3W_PROC(VertexAttribFormatNV)
+GL3W_PROC(VertexAttribI1i)
+GL3W_PROC(VertexAttribI1iv)
+GL3W_PROC(VertexAttribI1ui)
+GL3W_PROC(VertexAttribI1uiv)
+GL3W_PROC(VertexAttribI2i)
+GL3W_PROC(VertexAttribI2iv)
+GL3W_PROC(VertexAttribI2ui)
+GL3W_PROC(VertexAttribI2uiv)
+GL3W_PROC(VertexAttribI3i)
+GL3W_PROC(VertexAttribI3iv)
+GL3W_PROC(VertexAttribI3ui)
+GL3W_PROC(VertexAttribI3uiv)
+GL3W_PROC(VertexAttribI4bv)
+GL3W_PROC(VertexAttribI4i)
+GL3W_PROC(VertexAttribI4iv)
+GL3W_PROC(VertexAttribI4sv)
+GL3W_PROC(VertexAttribI4ubv)
+GL3W_PROC(VertexAttribI4ui)
+GL3W_PROC(VertexAttribI4uiv)
+GL3W_PROC(VertexAttribI4usv)
+GL3W_PROC(VertexAttribIFormat)
+GL3W_PROC(VertexAttribIFormatNV)
+GL3W_PROC(VertexAttribIPointer)
+GL3W_PROC(VertexAttribL1d)
+GL3W_PROC(VertexAttribL1dv)
+GL3W_PROC(VertexAttribL1i64NV)
+GL3W_PROC(VertexAttribL1i64vNV)
+GL3W_PROC(VertexAttribL1ui64ARB)
+GL3W_PROC(VertexAttribL1ui64NV)
+GL3W_PROC(VertexAttribL1ui64vARB)
+GL3W_PROC(VertexAttribL1ui64vNV)
+GL3W_PROC(VertexAttribL2d)
+GL3W_PROC(VertexAttribL2dv)
+GL3W_PROC(VertexAttribL2i64NV)
+GL3W_PROC(VertexAttribL2i64vNV)
+GL3W_PROC(VertexAttribL2ui64NV)
+GL3W_PROC(VertexAttribL2ui64vNV)
+GL3W_PROC(VertexAttribL3d)
+GL3W_PROC(VertexAttribL3dv)
+GL3W_PROC(VertexAttribL3i64NV)
+GL3W_PROC(VertexAttribL3i64vNV)
+GL3W_PROC(VertexAttribL3ui64NV)
+GL3W_PROC(VertexAttribL3ui64vNV)
+GL3W_PROC(VertexAttribL4d)
+GL3W_PROC(VertexAttribL4dv)
+GL3W_PROC(VertexAttribL4i64NV)
+GL3W_PROC(VertexAttribL4i64vNV)
+GL3W_PROC(VertexAttribL4ui64NV)
+GL3W_PROC(VertexAttribL4ui64vNV)
+GL3W_PROC(VertexAttribLFormat)
+GL3W_PROC(VertexAttribLFormatNV)
+GL3W_PROC(VertexAttribLPointer)
+GL3W_PROC(VertexAttribP1ui)
+GL3W_PROC(VertexAttribP1uiv)
+GL3W_PROC(VertexAttribP2ui)
+GL3W_PROC(VertexAttribP2uiv)
+GL3W_PROC(VertexAttribP3ui)
+GL3W_PROC(VertexAttribP3uiv)
+GL3W_PROC(VertexAttribP4ui)
+GL3W_PROC(VertexAttribP4uiv)
+GL3W_PROC(VertexAttribPointer)
+GL3W_PROC(VertexBindingDivisor)
+GL3W_PROC(VertexFormatNV)
+GL3W_PROC(Viewport)
+GL3W_PROC(ViewportArrayv)
+GL3W_PROC(ViewportIndexedf)
+GL3W_PROC(ViewportIndexedfv)
+GL3W_PROC(ViewportPositionWScaleNV)
+GL3W_PROC(ViewportSwizzleNV)
+GL3W_PROC(WaitSync)
+GL3W_PROC(WaitVkSemaphoreNV)
+GL3W_PROC(WeightPathsNV)
+GL3W_PROC(WindowRectanglesEXT)
@@ -0,0 +1,128 @@
+// Header
+#include "gl_state.hpp"
+
+namespace
+{
+	// Never returned by glGen*/glCreateProgram, marks a binding as unknown
+	const GLuint UNKNOWN = ~0u;
+}
+
+const GLuint GLState::MAX_TEXTURE_UNITS;
+
+int GLState::Counters::total()const
+{
+	return program_changes + vertex_array_changes + texture_changes + blend_changes + depth_changes;
+}
+
+GLState& GLState::instance()
+{
+	static GLState state;
+	return state;
+}
+
+GLState::GLState()
+{
+	begin_frame();
+}
+
+void GLState::begin_frame()
+{
+	m_program = UNKNOWN;
+	m_vertex_array = UNKNOWN;
+	m_active_unit = UNKNOWN;
+	for (GLuint& texture : m_textures)
+		texture = UNKNOWN;
+	m_blend = FLAG_UNKNOWN;
+	m_blend_src = GL_NONE;
+	m_blend_dst = GL_NONE;
+	m_depth_test = FLAG_UNKNOWN;
+	m_counters = Counters();
+}
+
+void GLState::use_program(GLuint program)
+{
+	if (program == m_program)
+	{
+		++m_counters.elided;
+		return;
+	}
+	glUseProgram(program);
+	m_program = program;
+	++m_counters.program_changes;
+}
+
+void GLState::bind_vertex_array(GLuint vao)
+{
+	if (vao == m_vertex_array)
+	{
+		++m_counters.elided;
+		return;
+	}
+	glBindVertexArray(vao);
+	m_vertex_array = vao;
+	++m_counters.vertex_array_changes;
+}
+
+void GLState::bind_texture(GLuint unit, GLuint texture)
+{
+	if (texture == m_textures[unit])
+	{
+		++m_counters.elided;
+		return;
+	}
+	active_texture(unit);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	m_textures[unit] = texture;
+	++m_counters.texture_changes;
+}
+
+void GLState::enable_blend(GLenum src_factor, GLenum dst_factor)
+{
+	if (m_blend != FLAG_ON)
+	{
+		glEnable(GL_BLEND);
+		m_blend = FLAG_ON;
+		++m_counters.blend_changes;
+	}
+	else
+		++m_counters.elided;
+
+	if (src_factor != m_blend_src || dst_factor != m_blend_dst)
+	{
+		glBlendFunc(src_factor, dst_factor);
+		m_blend_src = src_factor;
+		m_blend_dst = dst_factor;
+		++m_counters.blend_changes;
+	}
+	else
+		++m_counters.elided;
+}
+
+void GLState::set_depth_test(bool enabled)
+{
+	int flag = enabled ? FLAG_ON : FLAG_OFF;
+	if (flag == m_depth_test)
+	{
+		++m_counters.elided;
+		return;
+	}
+	if (enabled)
+		glEnable(GL_DEPTH_TEST);
+	else
+		glDisable(GL_DEPTH_TEST);
+	m_depth_test = flag;
+	++m_counters.depth_changes;
+}
+
+const GLState::Counters& GLState::get_counters()const
+{
+	return m_counters;
+}
+
+void GLState::active_texture(GLuint unit)
+{
+	if (unit == m_active_unit)
+		return;
+	glActiveTexture(GL_TEXTURE0 + unit);
+	m_active_unit = unit;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "common.hpp"
+
+// Shadows the pipeline state touched by draw() functions and only forwards calls that
+// change it, so drawing many entities with the same program, texture or blend mode does
+// not repeat the same driver calls. The shadow is dropped by begin_frame(): code running
+// outside of draw (loading, destroy) talks to GL directly and may leave anything bound.
+class GLState
+{
+public:
+	static const GLuint MAX_TEXTURE_UNITS = 8;
+
+	// State changes forwarded to GL since the last begin_frame(), and calls skipped
+	struct Counters
+	{
+		int program_changes;
+		int vertex_array_changes;
+		int texture_changes;
+		int blend_changes;
+		int depth_changes;
+		int elided;
+
+		int total()const;
+	};
+
+	static GLState& instance();
+
+	// Forgets the shadowed state and clears the counters, called before rendering a frame
+	void begin_frame();
+
+	void use_program(GLuint program);
+	void bind_vertex_array(GLuint vao);
+
+	// Binds texture to GL_TEXTURE_2D of the given unit
+	void bind_texture(GLuint unit, GLuint texture);
+
+	void enable_blend(GLenum src_factor, GLenum dst_factor);
+	void set_depth_test(bool enabled);
+
+	const Counters& get_counters()const;
+
+private:
+	GLState();
+	GLState(const GLState&) = delete;
+	GLState& operator=(const GLState&) = delete;
+
+	void active_texture(GLuint unit);
+
+	// Tri-state flags, -1 until the state is known
+	enum Flag { FLAG_UNKNOWN = -1, FLAG_OFF = 0, FLAG_ON = 1 };
+
+	GLuint m_program;
+	GLuint m_vertex_array;
+	GLuint m_active_unit;
+	GLuint m_textures[MAX_TEXTURE_UNITS];
+	int m_blend;
+	GLenum m_blend_src;
+	GLenum m_blend_dst;
+	int m_depth_test;
+	Counters m_counters;
+};
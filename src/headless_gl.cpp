@@ -0,0 +1,175 @@
+// Header
+#include "headless_gl.hpp"
+
+// stlib
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+	bool installed = false;
+
+	// Names handed out by every glGen*/glCreate*, shared so they are never 0
+	GLuint next_name = 1;
+
+	// Every entry point without a stand-in stops the run here and says which one it is, instead
+	// of crashing on a null pointer in headless builds only
+	void missing(const char* name)
+	{
+		fprintf(stderr, "Headless GL: %s has no stand-in, add one to install_headless_gl()\n", name);
+		abort();
+	}
+
+#define GL3W_PROC(name) void APIENTRY trap_##name() { missing("gl" #name); }
+#include "gl3w_procs.inl"
+#undef GL3W_PROC
+
+	// Stands in for every entry point whose only effect is on the GPU
+	template <typename... Args>
+	void APIENTRY ignore(Args...)
+	{
+	}
+
+	void APIENTRY gen_names(GLsizei n, GLuint* names)
+	{
+		for (GLsizei i = 0; i < n; ++i)
+			names[i] = next_name++;
+	}
+
+	GLuint APIENTRY create_program()
+	{
+		return next_name++;
+	}
+
+	GLuint APIENTRY create_shader(GLenum)
+	{
+		return next_name++;
+	}
+
+	GLenum APIENTRY get_error()
+	{
+		return GL_NO_ERROR;
+	}
+
+	GLenum APIENTRY check_framebuffer_status(GLenum)
+	{
+		return GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	// Compiles and links always succeed, programs have no active uniform or attribute
+	void APIENTRY get_shader_iv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+	}
+
+	void APIENTRY get_program_iv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+	}
+
+	void APIENTRY get_info_log(GLuint, GLsizei buf_size, GLsizei* length, GLchar* log)
+	{
+		if (length != nullptr)
+			*length = 0;
+		if (buf_size > 0)
+			log[0] = '\0';
+	}
+
+	void APIENTRY get_active(GLuint, GLuint, GLsizei buf_size, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+	{
+		if (length != nullptr)
+			*length = 0;
+		*size = 0;
+		*type = GL_FLOAT;
+		if (buf_size > 0)
+			name[0] = '\0';
+	}
+
+	GLint APIENTRY get_location(GLuint, const GLchar*)
+	{
+		return -1;
+	}
+}
+
+void install_headless_gl()
+{
+	// Traps first, the stand-ins below replace the ones the game is known to call
+#define GL3W_PROC(name) gl3w##name = (decltype(gl3w##name))trap_##name;
+#include "gl3w_procs.inl"
+#undef GL3W_PROC
+	installed = true;
+
+	glGenBuffers = gen_names;
+	glGenFramebuffers = gen_names;
+	glGenRenderbuffers = gen_names;
+	glGenTextures = gen_names;
+	glGenVertexArrays = gen_names;
+	glCreateProgram = create_program;
+	glCreateShader = create_shader;
+	glGetError = get_error;
+	glCheckFramebufferStatus = check_framebuffer_status;
+	glGetShaderiv = get_shader_iv;
+	glGetProgramiv = get_program_iv;
+	glGetShaderInfoLog = get_info_log;
+	glGetProgramInfoLog = get_info_log;
+	glGetActiveAttrib = get_active;
+	glGetActiveUniform = get_active;
+	glGetAttribLocation = get_location;
+	glGetUniformLocation = get_location;
+
+	glActiveTexture = ignore;
+	glAttachShader = ignore;
+	glBindBuffer = ignore;
+	glBindFramebuffer = ignore;
+	glBindRenderbuffer = ignore;
+	glBindTexture = ignore;
+	glBindVertexArray = ignore;
+	glBlendFunc = ignore;
+	glBufferData = ignore;
+	glBufferSubData = ignore;
+	glClear = ignore;
+	glClearColor = ignore;
+	glClearDepth = ignore;
+	glCompileShader = ignore;
+	glDeleteBuffers = ignore;
+	glDeleteFramebuffers = ignore;
+	glDeleteProgram = ignore;
+	glDeleteRenderbuffers = ignore;
+	glDeleteShader = ignore;
+	glDeleteTextures = ignore;
+	glDeleteVertexArrays = ignore;
+	glDepthRange = ignore;
+	glDetachShader = ignore;
+	glDisable = ignore;
+	glDrawArrays = ignore;
+	glDrawBuffers = ignore;
+	glDrawElements = ignore;
+	glDrawElementsInstanced = ignore;
+	glEnable = ignore;
+	glEnableVertexAttribArray = ignore;
+	glFramebufferRenderbuffer = ignore;
+	glFramebufferTexture = ignore;
+	glLinkProgram = ignore;
+	glPixelStorei = ignore;
+	glRenderbufferStorage = ignore;
+	glShaderSource = ignore;
+	glTexImage2D = ignore;
+	glTexParameteri = ignore;
+	glUniform1f = ignore;
+	glUniform1i = ignore;
+	glUniform1iv = ignore;
+	glUniform2f = ignore;
+	glUniform3f = ignore;
+	glUniform3fv = ignore;
+	glUniform4fv = ignore;
+	glUniformMatrix3fv = ignore;
+	glUseProgram = ignore;
+	glVertexAttribDivisor = ignore;
+	glVertexAttribPointer = ignore;
+	glViewport = ignore;
+}
+
+bool is_headless_gl()
+{
+	return installed;
+}
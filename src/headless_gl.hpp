@@ -0,0 +1,14 @@
+#pragma once
+
+#include "common.hpp"
+
+// Points every GL entry point the game calls at a stand-in that needs no context, so World
+// can run without a window or a GPU. Object creation hands out fresh non-zero names,
+// queries report success and everything else does nothing. Every other gl3w entry point
+// aborts with its name. Replaces gl3w_init().
+void install_headless_gl();
+
+// True once install_headless_gl() ran. The caches owning render resources (textures, font
+// atlases, shader programs) then skip decoding, rasterizing and reading shader sources, and
+// only keep what the simulation reads, like texture sizes.
+bool is_headless_gl();
@@ -1,5 +1,6 @@
 // Header
 #include "Hero.hpp"
+#include "gl_state.hpp"
 
 // internal
 #include "enemy_01.hpp"
@@ -26,6 +27,7 @@ bool Hero::init(vec2 screen)
     hero_texture.totalTiles = 21; // custom to current sprite sheet
     hero_texture.subWidth = 64; // custom to current sprite sheet
     m_is_alive = false;
+    previous_position.reset();
 
 	// Load shared texture
 	if (!hero_texture.is_valid())
@@ -43,27 +45,30 @@ bool Hero::init(vec2 screen)
 	float wr = tileWidth * 0.5f;
 	float hr = hero_texture.height * 0.5f;
 
-	texVertices[0].position = { -wr, +hr, -0.01f };
-    texVertices[1].position = { +wr, +hr, -0.01f };
-	texVertices[2].position = { +wr, -hr, -0.01f };
-	texVertices[3].position = { -wr, -hr, -0.01f };
-
-    for (int i = 0; i <= hero_texture.totalTiles; i++) {
-        texture_locs.push_back((float)i * hero_texture.subWidth / hero_texture.width);
-    }
-
-    glGenBuffers(1, &mesh.vbo);
-    glGenBuffers(1, &mesh.ibo);
-    setTextureLocs(14);
+	// Frames and clips are shared by every hero, walk cycles are authored at 3 frames per second
+	if (hero_texture.frames.empty())
+	{
+		hero_texture.build_frames(hero_texture.totalTiles);
+		hero_texture.animations.add("walk_front", { 0, 4, 1000.f / 3.f, true });
+		hero_texture.animations.add("walk_back", { 4, 4, 1000.f / 3.f, true });
+		hero_texture.animations.add("walk_right", { 8, 5, 1000.f / 3.f, true });
+		hero_texture.animations.add("stand", { 14, 1, 1000.f / 3.f, true });
+		hero_texture.animations.add("walk_left", { 15, 4, 1000.f / 3.f, true });
+		hero_texture.animations.add("death", { 19, 2, 1000.f / 3.f, false });
+	}
 
-	// Vertex Array (Container for Vertex + Index buffer)
-	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors())
+	// The quad is uploaded once, animating only moves the window sampled from the sheet
+	if (!gl_create_sprite_quad(mesh, wr, hr, -0.01f))
 		return false;
+	m_moveState = HeroMoveState::STANDING;
+	m_animation = AnimationPlayer();
+	m_animation.play(hero_texture.animations.find("stand"));
+	setTextureLocs(m_animation.get_frame());
 
 	// Loading shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
+	if (!effect.load_from_file(shader_path("animated.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	// Setting initial values
 	m_scale.x = 1.f;
@@ -115,36 +120,34 @@ void Hero::destroy(bool reset)
 	glDeleteBuffers(1, &mesh.vbo);
 	glDeleteBuffers(1, &mesh.ibo);
 
-	glDeleteShader(effect.vertex);
-	glDeleteShader(effect.fragment);
-	glDeleteShader(effect.program);
-
 	if(reset) {
 		glDeleteVertexArrays(1, &mesh.vao);
-		glDetachShader(effect.program, effect.vertex);
-		glDetachShader(effect.program, effect.fragment);
+		effect.release();
 	}
 }
 
 // Called on each frame by World::update()
 void Hero::update(float ms)
 {
+	// Momentum and mana regeneration are tuned per 60 Hz frame
+	float frames = ms / REFERENCE_FRAME_MS;
+
 	//momentum first
-	m_position.x += momentum.x;
-	m_position.y += momentum.y;
+	m_position.x += momentum.x * frames;
+	m_position.y += momentum.y * frames;
 
 	if (momentum.x > 0.5f) {
-		momentum.x = std::max(momentum.x - deceleration, 0.f);
+		momentum.x = std::max(momentum.x - deceleration * frames, 0.f);
 	}
 	if (momentum.x < -0.5f) {
-		momentum.x = std::min(momentum.x + deceleration, 0.f);
+		momentum.x = std::min(momentum.x + deceleration * frames, 0.f);
 	}
 
 	if (momentum.y > 0.5f) {
-		momentum.y = std::max(momentum.y - deceleration, 0.f);
+		momentum.y = std::max(momentum.y - deceleration * frames, 0.f);
 	}
 	if (momentum.y < -0.5f) {
-		momentum.y = std::min(momentum.y + deceleration, 0.f);
+		momentum.y = std::min(momentum.y + deceleration * frames, 0.f);
 	}
 
 	float step = movement_speed * (ms / 1000);
@@ -159,84 +162,59 @@ void Hero::update(float ms)
 
         if (mp < max_mp)
         {
-            mp += mp_recovery_rate;
+            mp += mp_recovery_rate * frames;
         }
 
-        // setting player movement state
+        // setting player movement state, the walk cycle plays faster the faster the hero moves
         if (m_direction.x > 0.0f && m_direction.y == 0.0f) {
-            animSpeed = abs(m_direction.x) * 0.025f;
+            animSpeed = abs(m_direction.x);
             if (m_moveState != HeroMoveState::RIGHTMOVING) {
                 m_moveState = HeroMoveState::RIGHTMOVING;
-                m_animTime = 0.0f;
+                m_animation.play(hero_texture.animations.find("walk_right"));
             }
         }
         else if (m_direction.x < 0.0f && m_direction.y == 0.0f){
-            animSpeed = abs(m_direction.x) * 0.025f;
+            animSpeed = abs(m_direction.x);
             if (m_moveState != HeroMoveState::LEFTMOVING) {
                 m_moveState = HeroMoveState::LEFTMOVING;
-                m_animTime = 0.0f;
+                m_animation.play(hero_texture.animations.find("walk_left"));
             }
         }
         else if (m_direction.y > 0.0f) {
-            animSpeed = abs(m_direction.y) * 0.025f;
+            animSpeed = abs(m_direction.y);
             if (m_moveState != HeroMoveState::FRONTMOVING) {
                 m_moveState = HeroMoveState::FRONTMOVING;
-                m_animTime = 0.0f;
+                m_animation.play(hero_texture.animations.find("walk_front"));
             }
         }
         else if (m_direction.y < 0.0f) {
-            animSpeed = abs(m_direction.y) * 0.025f;
+            animSpeed = abs(m_direction.y);
             if (m_moveState != HeroMoveState::BACKMOVING) {
                 m_moveState = HeroMoveState::BACKMOVING;
-                m_animTime = 0.0f;
+                m_animation.play(hero_texture.animations.find("walk_back"));
             }
         }
-        else {
+        else if (m_moveState != HeroMoveState::STANDING) {
             // load standing sprite
             m_moveState = HeroMoveState::STANDING;
-            m_animTime = 0.0f;
-        }
-        m_animTime += animSpeed * 2;
-
-        // setting texture coordinates
-        if (m_moveState == HeroMoveState::LEFTMOVING) {
-            int currIndex = 15;
-            numTiles = 4;
-            currIndex += (int)m_animTime % numTiles;
-            setTextureLocs(currIndex);
-        }
-        else if (m_moveState == HeroMoveState::RIGHTMOVING) {
-            int currIndex = 8;
-            numTiles = 5;
-            currIndex += (int)m_animTime % numTiles;
-            setTextureLocs(currIndex);
-        }
-        else if (m_moveState == HeroMoveState::FRONTMOVING) {
-            int currIndex = 0;
-            numTiles = 4;
-            currIndex += (int)m_animTime % numTiles;
-            setTextureLocs(currIndex);
-        }
-        else if (m_moveState == HeroMoveState::BACKMOVING) {
-            int currIndex = 4;
-            numTiles = 4;
-            currIndex += (int)m_animTime % numTiles;
-            setTextureLocs(currIndex);
-        }
-        else {
-            int currIndex = 14;
-            setTextureLocs(currIndex);
+            m_animation.play(hero_texture.animations.find("stand"));
         }
 	}
-	else
+	else if (m_moveState != HeroMoveState::DEAD)
 	{
 		// If dead we make it face upwards and sink deep down
-		int currIndex = 19;
-		numTiles = 2;
-		currIndex += (int)m_animTime % numTiles;
-		setTextureLocs(currIndex);
+		m_moveState = HeroMoveState::DEAD;
+		m_animation.play(hero_texture.animations.find("death"));
+	}
+	else
+	{
+		animSpeed = 1.f;
 	}
 
+	// setting texture coordinates
+	m_animation.update(ms, animSpeed);
+	setTextureLocs(m_animation.get_frame());
+
 
 	if (m_light_up_countdown_ms > 0.f) {
 		m_light_up_countdown_ms -= ms;
@@ -247,32 +225,7 @@ void Hero::update(float ms)
 }
 
 void Hero::setTextureLocs(int index) {
-
-    texVertices[0].texcoord = { texture_locs[index], 1.f }; //top left
-    texVertices[1].texcoord = { texture_locs[index + 1], 1.f }; //top right
-    texVertices[2].texcoord = { texture_locs[index + 1], 0.f }; //bottom right
-    texVertices[3].texcoord = { texture_locs[index], 0.f }; //bottom left
-
-    // counterclockwise as it's the default opengl front winding direction
-    uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-    // Clearing errors
-    gl_flush_errors();
-
-	// Clear memory allocation
-    if (m_is_alive) {
-        destroy(false);
-    }
-
-    // Vertex Buffer creation
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
-
-    // Index Buffer creation
-    glGenBuffers(1, &mesh.ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
+    m_frame = hero_texture.get_frame(index);
 }
 
 void Hero::draw(const mat3& projection)
@@ -283,18 +236,19 @@ void Hero::draw(const mat3& projection)
 	vec2 cur_pos = m_position;
 	float color[] = { 1.f, 1.f, 1.f };
 	if (isInTransition) {
-		if(clock() - transition_time <= 1500.f) {
-			if(clock() - transition_time > 600.f){
-				cur_pos.y -= (clock() - transition_time - 600.f) / 1.5f;
+		float transition_elapsed = GameClock::instance().since(transition_time);
+		if(transition_elapsed <= 1500.f) {
+			if(transition_elapsed > 600.f){
+				cur_pos.y -= (transition_elapsed - 600.f) / 1.5f;
 			}
-			float ratio = std::max(1 - ((clock() - transition_time) / transition_duration), 0.1f);
+			float ratio = std::max(1 - (transition_elapsed / transition_duration), 0.1f);
 			cur_scale.x = m_scale.x * ratio;
 			color[0] = color[0] + color[0] * (5 - 5 * ratio);
 			color[1] = color[1] + color[1] * (5 - 5 * ratio);
 			color[2] = color[2] + color[2] * (5 - 5 * ratio);
 		} else {
-			cur_pos.y -= (3000.f - (clock() - transition_time)) / 1.5f;
-			float ratio = std::min(((clock() - transition_time) / transition_duration), 1.f);
+			cur_pos.y -= (3000.f - transition_elapsed) / 1.5f;
+			float ratio = std::min((transition_elapsed / transition_duration), 1.f);
 			cur_scale.x = m_scale.x * ratio;
 			color[0] = color[0] + color[0] * (5 - 5 * ratio);
 			color[1] = color[1] + color[1] * (5 - 5 * ratio);
@@ -314,50 +268,50 @@ void Hero::draw(const mat3& projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	GLint light_up_uloc = glGetUniformLocation(effect.program, "light_up");
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
+	GLint light_up_uloc = effect.locations->light_up;
+	GLint uv_offset_uloc = effect.locations->uv_offset;
+	GLint uv_scale_uloc = effect.locations->uv_scale;
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, hero_texture.id);
+	GLState::instance().bind_texture(0, hero_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
 	glUniform1iv(light_up_uloc, 1, &m_light_up);
+	m_frame.set_uniforms(uv_offset_uloc, uv_scale_uloc);
 
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
+}
 
-	if (isInTransition && clock() - transition_time > transition_duration) {
+void Hero::update_transition()
+{
+	if (isInTransition && GameClock::instance().since(transition_time) > transition_duration) {
 		isInTransition = false;
 		justFinishedTransition = true;
 	}
 }
 
+GLuint Hero::get_texture_id()const
+{
+	return hero_texture.id;
+}
+
 // Simple bounding box collision check,
 bool Hero::collides_with(const Enemy_02& enemy)
 {
@@ -385,20 +339,18 @@ bool Hero::collides_with(const Enemy_02& enemy)
         bottom =  enemy.get_bounding_box().y / scale_back;
         left = -1.f * enemy.get_bounding_box().x / scale_back;
         right = enemy.get_bounding_box().x / scale_back;
-		//points before transform
-        vec3 p_top,p_left,p_right,p_bottom;
-
-		//could add a list of points to test for our game
-        p_top = mul_vec(enemy.transform,{0,top,1});
-        p_bottom = mul_vec(enemy.transform,{0,bottom,1});
-        p_left = mul_vec(enemy.transform,{left,0,1});
-        p_right = mul_vec(enemy.transform,{right,0,1});
-
-        std::vector<vec3> cur_vertices;
-        transform_current_vertex(cur_vertices);
         if (d_sq < r * r) {
-            return mesh_collision(p_top,cur_vertices) || mesh_collision(p_bottom,cur_vertices)
-                   || mesh_collision(p_left,cur_vertices) || mesh_collision(p_right,cur_vertices);
+            //points before transform
+            vec3 local[] = { {0,top,1}, {0,bottom,1}, {left,0,1}, {right,0,1} };
+            vec2 points[4];
+            for (int i = 0; i < 4; ++i) {
+                vec3 p = mul_vec(enemy.transform, local[i]);
+                points[i] = { p.x, p.y };
+            }
+
+            // Every sample point in one batch against the hero mesh
+            m_collision_mesh.build(transform, vertices, indices);
+            return m_collision_mesh.contains(points, 4) != 0;
         }
 
     }
@@ -458,20 +410,18 @@ bool Hero::collides_with(const Fish& fish)
 		bottom =  fish.get_bounding_box().y / scale_back;
 		left = -1.f * fish.get_bounding_box().x / scale_back;
 		right = fish.get_bounding_box().x / scale_back;
-		//points before transform
-		vec3 p_top,p_left,p_right,p_bottom;
-
-		//could add a list of points to test for our game
-		p_top = mul_vec(fish.transform,{0,top,1});
-		p_bottom = mul_vec(fish.transform,{0,bottom,1});
-		p_left = mul_vec(fish.transform,{left,0,1});
-		p_right = mul_vec(fish.transform,{right,0,1});
-
-		std::vector<vec3> cur_vertices;
-		transform_current_vertex(cur_vertices);
 		if (d_sq < r * r) {
-			return mesh_collision(p_top,cur_vertices) || mesh_collision(p_bottom,cur_vertices)
-				   || mesh_collision(p_left,cur_vertices) || mesh_collision(p_right,cur_vertices);
+			//points before transform
+			vec3 local[] = { {0,top,1}, {0,bottom,1}, {left,0,1}, {right,0,1} };
+			vec2 points[4];
+			for (int i = 0; i < 4; ++i) {
+				vec3 p = mul_vec(fish.transform, local[i]);
+				points[i] = { p.x, p.y };
+			}
+
+			// Every sample point in one batch against the hero mesh
+			m_collision_mesh.build(transform, vertices, indices);
+			return m_collision_mesh.contains(points, 4) != 0;
 		}
 	}
 
@@ -533,55 +483,11 @@ HeroMoveState Hero::get_moveState()
     return m_moveState;
 }
 
-void Hero::transform_current_vertex(std::vector<vec3> &cur_vertices)
-{
-    for (size_t i = 0; i < vertices.size(); ++i) {
-        vec3 old_position = {vertices.at(i).position.x, vertices.at(i).position.y,1};
-        vec3 cur_position = mul_vec(transform, old_position);
-        cur_vertices.push_back(cur_position);
-    }
-}
-
 vec2 Hero::get_bounding_box()
 {
 	return { std::fabs(m_scale.x) * hero_texture.subWidth, std::fabs(m_scale.y) * hero_texture.height };
 }
 
-bool Hero::mesh_collision(vec3 ptest,std::vector<vec3> &cur_vertices)
-{
-
-    for (size_t i = 0; i < indices.size(); i+=3) {
-
-        //three vertices of a triangle
-        vec3 point1 = cur_vertices.at(indices[i]);
-        vec3 point2 = cur_vertices.at(indices[i+1]);
-        vec3 point3 = cur_vertices.at(indices[i+2]);
-
-        vec2 p1 = {point1.x, point1.y};
-        vec2 p1_p2 = {point2.x-point1.x,point2.y-point1.y};
-        vec2 p1_p3 = {point3.x-point1.x,point3.y-point1.y};
-        vec2 ptest2d = {ptest.x,ptest.y};
-
-        float a,b = 0.f;
-        float detv12 = det(p1_p2,p1_p3); //This should not be 0;
-        if (detv12 ==0)
-            return false;
-        float detvv2 = det(ptest2d,p1_p2);
-        float detvv3 = det(ptest2d,p1_p3);
-        float detv1v2 = det(p1,p1_p2);
-        float detv1v3 = det(p1,p1_p3);
-        a = (detvv2 - detv1v2) / detv12;
-        b = -1.f* (detvv3 - detv1v3) / detv12;
-
-        if (a>0 && b>0 && a+b <1.f) {
-            return true;
-        }
-
-    }
-
-    return false;
-}
-
 int Hero::get_active_skill()
 {
 	return activeSkill;
@@ -645,7 +551,10 @@ vec2 Hero::get_position()
 
 bool Hero::shoot_projectiles(std::vector<Projectile*> & hero_projectiles)
 {
-	Fireball* fireball = new Fireball(m_rotation, 400.f, 20.0f);
+	Fireball* fireball = Fireball::pool().acquire();
+	if (fireball == nullptr)
+		return false;
+	fireball->init(m_rotation, 400.f, 20.0f);
 	fireball->set_position(m_position);
 	hero_projectiles.emplace_back(fireball);
 	return true;
@@ -658,7 +567,7 @@ bool Hero::use_ice_arrow_skill(std::vector<Projectile*> & hero_projectiles)
     {
         float mp_cost = ice_arrow_skill.shoot_ice_arrow(hero_projectiles,m_rotation,m_position);
         change_mp(-1 * mp_cost);
-        return true;
+        return mp_cost > 0.f;
     }
     return false;
 
@@ -736,7 +645,7 @@ void Hero::set_active_skill(int active)
 void Hero::next_level()
 {
 	if(!isInTransition) {
-		transition_time = clock();
+		transition_time = GameClock::instance().now();
 		isInTransition = true;
 	}
 }
\ No newline at end of file
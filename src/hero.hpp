@@ -13,7 +13,8 @@
 #include "ThunderSkill.h"
 #include "phoenix_skill.h"
 #include "phoenix.h"
-#include "time.h"
+#include "triangle_soup.hpp"
+#include "game_clock.hpp"
 
 #define ICE_SKILL 0
 #define THUNDER_SKILL 1
@@ -43,8 +44,6 @@ public:
 	bool second_life;
 	//std::vector<skill> skill_list;
 
-    int numTiles = 1;
-
 	float m_color[3];
 	bool advanced;
 	vec2 m_screen;
@@ -60,6 +59,8 @@ public:
 	// Renders the salmon
 	void draw(const mat3& projection)override;
 
+	GLuint get_texture_id()const override;
+
 	// Collision routines for enemys and fish
 	bool collides_with(const Enemy_02& enemy);
 	bool collides_with(Projectile &projectile);
@@ -100,8 +101,6 @@ public:
     HeroMoveState get_moveState();
 
 	vec2 get_bounding_box();
-    bool mesh_collision(vec3 point, std::vector<vec3> &cur_vertices);
-    void transform_current_vertex(std::vector<vec3> &cur_vertices);
 	void set_color(vec3 color);
 
 	//hero functions
@@ -122,23 +121,26 @@ public:
 	void set_active_skill(int active);
 	int get_active_skill();
 	void next_level();
+	// Ends the level transition once it has played, every tick whether or not it is drawn
+	void update_transition();
 	vec2 m_scale; // 1.f in each dimension. 1.f is as big as the associated texture
+	PreviousPosition previous_position; // for drawing between simulation steps
 	int level;
 	bool isInTransition;
 	bool justFinishedTransition;
 
 
 private:
-    TexturedVertex texVertices[4];
-    std::vector<float> texture_locs;
+    SpriteFrame m_frame; // part of the sprite sheet currently displayed
 	float m_light_up_countdown_ms; // Used to keep track for how long the salmon should be lit up
 	bool m_is_alive; // True if the salmon is alive
 	vec2 m_position; // Window coordinates
 	float m_rotation; // in radians
 	size_t m_num_indices; // passed to glDrawElements
+	TriangleSoup m_collision_mesh; // mesh placed by the current transform, for the advanced checks
 
     // animation
-    float m_animTime = 0.0f;
+    AnimationPlayer m_animation;
     HeroMoveState m_moveState = HeroMoveState::STANDING;
 
 	//add salmon speed
@@ -152,7 +154,7 @@ private:
 	vec2 momentum;
     float deceleration;
     float momentum_factor;
-	clock_t transition_time;
+	double transition_time;
 	float transition_duration;
 	bool just_took_damage;
 };
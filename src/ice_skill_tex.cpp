@@ -1,4 +1,5 @@
 #include "ice_skill_tex.hpp"
+#include "gl_state.hpp"
 
 #include <iostream>
 
@@ -50,6 +51,7 @@ bool Iceskilltex::init(vec2 screen, int skill_num)
 	// Loading shaders
 	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	m_scale = { 1.0f,1.0f };
 
@@ -74,34 +76,23 @@ void Iceskilltex::draw(const mat3 & projection)
 		transform_scale(m_scale);
 		transform_end();
 
-		glUseProgram(effect.program);
+		GLState::instance().use_program(effect.program);
 
 		// Enabling alpha channel for textures
-		glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glDisable(GL_DEPTH_TEST);
+		GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		GLState::instance().set_depth_test(false);
 
 		// Getting uniform locations for glUniform* calls
-		GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-		GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-		GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
-		GLint light_up_uloc = glGetUniformLocation(effect.program, "light_up");
+		GLint transform_uloc = effect.locations->transform;
+		GLint color_uloc = effect.locations->fcolor;
+		GLint projection_uloc = effect.locations->projection;
+		GLint light_up_uloc = effect.locations->light_up;
 
 		// Setting vertices and indices
-		glBindVertexArray(mesh.vao);
-		glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-		// Input data location as in the vertex buffer
-		GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-		GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-		glEnableVertexAttribArray(in_position_loc);
-		glEnableVertexAttribArray(in_texcoord_loc);
-		glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-		glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+		GLState::instance().bind_vertex_array(mesh.vao);
 
 		// Enabling and binding texture to slot 0
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, ice_texture.id);
+		GLState::instance().bind_texture(0, ice_texture.id);
 
 		// Setting uniform values to the currently bound program
 		glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
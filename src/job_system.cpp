@@ -0,0 +1,246 @@
+// Header
+#include "job_system.hpp"
+
+// stlib
+#include <algorithm>
+#include <cstdio>
+#include <system_error>
+
+namespace
+{
+	// Queue of the calling thread, workers are 1..N and everybody else shares 0
+	thread_local unsigned t_queue = 0;
+}
+
+JobSystem& JobSystem::instance()
+{
+	static JobSystem jobs;
+	return jobs;
+}
+
+JobSystem::JobSystem() :
+	m_queued(0),
+	m_running(false)
+{
+	m_queues.emplace_back(new Queue());
+}
+
+bool JobSystem::init(unsigned worker_count)
+{
+	if (m_running)
+		return true;
+
+	if (worker_count == 0)
+	{
+		unsigned cores = std::thread::hardware_concurrency();
+		worker_count = cores > 1 ? cores - 1 : 0;
+	}
+
+	m_running = true;
+	for (unsigned i = 1; i <= worker_count; ++i)
+		m_queues.emplace_back(new Queue());
+	for (unsigned i = 1; i <= worker_count; ++i)
+	{
+		try
+		{
+			m_threads.emplace_back(&JobSystem::worker_loop, this, i);
+		}
+		catch (const std::system_error&)
+		{
+			// Fewer workers is fine, the jobs of queues without one get stolen
+			fprintf(stderr, "Failed to start job worker %u", i);
+			break;
+		}
+	}
+	return true;
+}
+
+void JobSystem::destroy()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_running = false;
+	}
+	m_wake.notify_all();
+	for (auto& thread : m_threads)
+		thread.join();
+	m_threads.clear();
+
+	// Whatever is left runs here, nobody else will
+	Job job;
+	while (take(0, job))
+		execute(job);
+	m_queues.resize(1);
+}
+
+unsigned JobSystem::get_worker_count()const
+{
+	return (unsigned)m_threads.size();
+}
+
+void JobSystem::submit(std::function<void()> job, std::atomic<int>& pending)
+{
+	if (m_threads.empty())
+	{
+		job();
+		--pending;
+		return;
+	}
+
+	unsigned self = std::min(t_queue, (unsigned)m_queues.size() - 1);
+	{
+		std::lock_guard<std::mutex> lock(m_queues[self]->mutex);
+		m_queues[self]->jobs.push_back({ std::move(job), &pending });
+	}
+	{
+		// Taken so a worker can't miss the wake up between checking and sleeping
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		++m_queued;
+	}
+	m_wake.notify_one();
+}
+
+void JobSystem::wait(const std::atomic<int>& pending)
+{
+	unsigned self = std::min(t_queue, (unsigned)m_queues.size() - 1);
+	Job job;
+	while (pending > 0)
+	{
+		if (take(self, job))
+			execute(job);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn)
+{
+	if (count == 0)
+		return;
+	grain = std::max(grain, (size_t)1);
+	if (m_threads.empty() || count <= grain)
+	{
+		fn(0, count);
+		return;
+	}
+
+	// The caller keeps the first range for itself
+	std::atomic<int> pending(0);
+	for (size_t begin = grain; begin < count; begin += grain)
+	{
+		size_t end = std::min(begin + grain, count);
+		++pending;
+		submit([&fn, begin, end]() { fn(begin, end); }, pending);
+	}
+	fn(0, grain);
+	wait(pending);
+}
+
+bool JobSystem::take(unsigned self, Job& out)
+{
+	size_t queues = m_queues.size();
+	for (size_t i = 0; i < queues; ++i)
+	{
+		size_t index = (self + i) % queues;
+		Queue& queue = *m_queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty())
+			continue;
+
+		if (i == 0)
+		{
+			out = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+		}
+		else
+		{
+			out = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+		}
+		--m_queued;
+		return true;
+	}
+	return false;
+}
+
+void JobSystem::execute(Job& job)
+{
+	job.run();
+	job.run = nullptr;
+	--*job.pending;
+}
+
+void JobSystem::worker_loop(unsigned index)
+{
+	t_queue = index;
+	Job job;
+	while (true)
+	{
+		if (take(index, job))
+		{
+			execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wake_mutex);
+		m_wake.wait(lock, [this]() { return m_queued > 0 || !m_running; });
+		if (!m_running && m_queued == 0)
+			return;
+	}
+}
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> task)
+{
+	Node node;
+	node.task = std::move(task);
+	node.dependencies = 0;
+	m_nodes.push_back(std::move(node));
+	return m_nodes.size() - 1;
+}
+
+void TaskGraph::depend(TaskId task, TaskId first)
+{
+	m_nodes[first].successors.push_back(task);
+	++m_nodes[task].dependencies;
+}
+
+void TaskGraph::run()
+{
+	if (m_nodes.empty())
+		return;
+
+	if (m_remaining_size < m_nodes.size())
+	{
+		m_remaining.reset(new std::atomic<int>[m_nodes.size()]);
+		m_remaining_size = m_nodes.size();
+	}
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+		m_remaining[i] = m_nodes[i].dependencies;
+
+	std::atomic<int> pending((int)m_nodes.size());
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		if (m_nodes[i].dependencies == 0)
+			launch(i, pending);
+	}
+	JobSystem::instance().wait(pending);
+}
+
+void TaskGraph::clear()
+{
+	m_nodes.clear();
+}
+
+void TaskGraph::launch(TaskId id, std::atomic<int>& pending)
+{
+	// Each job accounts for its own node, successors are counted when they are launched
+	std::atomic<int>* done = &pending;
+	JobSystem::instance().submit([this, id, done]() {
+		m_nodes[id].task();
+		for (TaskId next : m_nodes[id].successors)
+		{
+			if (--m_remaining[next] == 0)
+				launch(next, *done);
+		}
+	}, pending);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// stlib
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process-wide pool of worker threads with one job deque each. A thread pushes and pops its
+// own jobs at the back and steals from the front of the others when it runs dry. Threads
+// waiting on jobs (the main thread included) run queued jobs instead of blocking, so work can
+// be split from inside a job too. Without workers every job runs inline on the caller.
+class JobSystem
+{
+public:
+	static JobSystem& instance();
+
+	// Starts worker_count threads, one less than the number of cores when 0
+	bool init(unsigned worker_count = 0);
+
+	// Finishes the queued jobs and joins the workers
+	void destroy();
+
+	unsigned get_worker_count()const;
+
+	// Queues job, pending is decremented once it has run
+	void submit(std::function<void()> job, std::atomic<int>& pending);
+
+	// Runs queued jobs until pending drops to 0
+	void wait(const std::atomic<int>& pending);
+
+	// Calls fn(begin, end) on consecutive ranges of at most grain items covering [0, count)
+	// and returns once all of them ran. Ranges must not touch the same data.
+	void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+private:
+	JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	struct Job
+	{
+		std::function<void()> run;
+		std::atomic<int>* pending;
+	};
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	// Own queue first (newest job), then the oldest job of every other queue
+	bool take(unsigned self, Job& out);
+	void execute(Job& job);
+	void worker_loop(unsigned index);
+
+	std::vector<std::unique_ptr<Queue>> m_queues; // 0 is for threads that are not workers
+	std::vector<std::thread> m_threads;
+	std::mutex m_wake_mutex;
+	std::condition_variable m_wake;
+	std::atomic<int> m_queued;
+	std::atomic<bool> m_running;
+};
+
+// Set of jobs with ordering constraints between them, run on the JobSystem. A task starts once
+// every task it depends on finished, independent tasks run concurrently. The graph can be
+// cleared and refilled every tick.
+class TaskGraph
+{
+public:
+	typedef size_t TaskId;
+
+	TaskId add(std::function<void()> task);
+
+	// task won't start before first is done
+	void depend(TaskId task, TaskId first);
+
+	// Runs every task once and returns when all of them are done
+	void run();
+
+	void clear();
+
+private:
+	struct Node
+	{
+		std::function<void()> task;
+		std::vector<TaskId> successors;
+		int dependencies;
+	};
+
+	void launch(TaskId id, std::atomic<int>& pending);
+
+	std::vector<Node> m_nodes;
+	std::unique_ptr<std::atomic<int>[]> m_remaining; // unfinished dependencies of each node
+	size_t m_remaining_size = 0;
+};
@@ -22,6 +22,8 @@ public:
 
 	// Renders
 	void draw(const mat3& projection)override;
+
+	GLuint get_texture_id()const override;
 	void update(Mapscreen s);
 	vec2 set_scale(float w, float h, vec2 screen);
 	bool is_over();
@@ -0,0 +1,81 @@
+#pragma once
+
+// stlib
+#include <vector>
+
+// Fixed-capacity pool of T, allocated in one block on first use. acquire() hands out a
+// free object and release() takes it back, so spawning and despawning never touch the heap.
+// Objects are recycled as they are, whatever they own (GPU buffers included) is kept for
+// the next user, which is expected to call the object's init() again.
+// Pointers stay valid until clear(), which destroys every object.
+template <typename T>
+class ObjectPool
+{
+public:
+	explicit ObjectPool(size_t capacity) :
+		m_capacity(capacity)
+	{
+	}
+
+	// Returns a free object, or nullptr when all of them are in use
+	T* acquire()
+	{
+		if (m_objects.empty())
+			allocate();
+		if (m_free.empty())
+			return nullptr;
+
+		T* object = m_free.back();
+		m_free.pop_back();
+		m_in_use[object - m_objects.data()] = true;
+		return object;
+	}
+
+	// Gives object back, objects that are not from this pool or already free are ignored
+	void release(T* object)
+	{
+		if (m_objects.empty() || object < m_objects.data() || object >= m_objects.data() + m_objects.size())
+			return;
+
+		size_t index = object - m_objects.data();
+		if (!m_in_use[index])
+			return;
+		m_in_use[index] = false;
+		m_free.push_back(object);
+	}
+
+	// Destroys every object, acquire() allocates a new block afterwards
+	void clear()
+	{
+		std::vector<T>().swap(m_objects);
+		m_free.clear();
+		m_in_use.clear();
+	}
+
+	size_t capacity()const
+	{
+		return m_capacity;
+	}
+
+	// Number of objects currently handed out
+	size_t size()const
+	{
+		return m_objects.size() - m_free.size();
+	}
+
+private:
+	void allocate()
+	{
+		m_objects = std::vector<T>(m_capacity);
+		m_in_use.assign(m_capacity, false);
+		m_free.reserve(m_capacity);
+		// The free list is a stack, the last released object is the next one handed out
+		for (size_t i = m_capacity; i > 0; --i)
+			m_free.push_back(&m_objects[i - 1]);
+	}
+
+	std::vector<T> m_objects;
+	std::vector<T*> m_free;
+	std::vector<bool> m_in_use;
+	size_t m_capacity;
+};
@@ -0,0 +1,220 @@
+// Header
+#include "obstacle_field.hpp"
+
+// stlib
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+	// Obstacle indices are stored per node on a byte
+	const size_t MAX_OBSTACLES = 255;
+}
+
+ObstacleField::ObstacleField(float cell_size) :
+	m_origin({ 0.f, 0.f }),
+	m_cell_size(cell_size),
+	m_cols(0),
+	m_rows(0)
+{
+}
+
+void ObstacleField::clear()
+{
+	m_obstacles.clear();
+	m_hull_points.clear();
+	m_distances.clear();
+	m_nearest.clear();
+	m_cols = 0;
+	m_rows = 0;
+}
+
+void ObstacleField::add_circle(vec2 center, float radius, float push)
+{
+	if (m_obstacles.size() >= MAX_OBSTACLES)
+	{
+		fprintf(stderr, "Too many obstacles in the field");
+		return;
+	}
+
+	Obstacle obstacle;
+	obstacle.center = center;
+	obstacle.radius = radius;
+	obstacle.first = 0;
+	obstacle.count = 0;
+	obstacle.push = push;
+	m_obstacles.push_back(obstacle);
+}
+
+void ObstacleField::add_hull(const std::vector<vec2>& points, float push)
+{
+	if (points.size() < 3)
+		return;
+	if (m_obstacles.size() >= MAX_OBSTACLES)
+	{
+		fprintf(stderr, "Too many obstacles in the field");
+		return;
+	}
+
+	Obstacle obstacle;
+	obstacle.center = { 0.f, 0.f };
+	obstacle.radius = 0.f;
+	obstacle.first = m_hull_points.size();
+	obstacle.count = points.size();
+	obstacle.push = push;
+	for (const vec2& p : points)
+	{
+		obstacle.center.x += p.x / points.size();
+		obstacle.center.y += p.y / points.size();
+	}
+	for (const vec2& p : points)
+	{
+		float dx = p.x - obstacle.center.x;
+		float dy = p.y - obstacle.center.y;
+		obstacle.radius = std::max(obstacle.radius, std::sqrt(dx * dx + dy * dy));
+	}
+	m_hull_points.insert(m_hull_points.end(), points.begin(), points.end());
+	m_obstacles.push_back(obstacle);
+}
+
+void ObstacleField::build(float margin)
+{
+	m_distances.clear();
+	m_nearest.clear();
+	m_cols = 0;
+	m_rows = 0;
+	if (m_obstacles.empty())
+		return;
+
+	// Bounding circles are enough to size the grid
+	vec2 min = { FLT_MAX, FLT_MAX };
+	vec2 max = { -FLT_MAX, -FLT_MAX };
+	for (const Obstacle& obstacle : m_obstacles)
+	{
+		min = { std::min(min.x, obstacle.center.x - obstacle.radius), std::min(min.y, obstacle.center.y - obstacle.radius) };
+		max = { std::max(max.x, obstacle.center.x + obstacle.radius), std::max(max.y, obstacle.center.y + obstacle.radius) };
+	}
+
+	m_origin = { min.x - margin, min.y - margin };
+	m_cols = std::max(1, (int)std::ceil((max.x - min.x + 2.f * margin) / m_cell_size));
+	m_rows = std::max(1, (int)std::ceil((max.y - min.y + 2.f * margin) / m_cell_size));
+
+	size_t nodes = (size_t)(m_cols + 1) * (size_t)(m_rows + 1);
+	m_distances.resize(nodes);
+	m_nearest.resize(nodes);
+	for (int y = 0; y <= m_rows; ++y)
+	{
+		for (int x = 0; x <= m_cols; ++x)
+		{
+			vec2 p = { m_origin.x + x * m_cell_size, m_origin.y + y * m_cell_size };
+			int nearest = 0;
+			size_t i = (size_t)y * (m_cols + 1) + x;
+			m_distances[i] = exact_distance(p, nearest);
+			m_nearest[i] = (uint8_t)nearest;
+		}
+	}
+}
+
+bool ObstacleField::sample(vec2 point, Sample& out)const
+{
+	if (m_distances.empty())
+		return false;
+
+	float fx = (point.x - m_origin.x) / m_cell_size;
+	float fy = (point.y - m_origin.y) / m_cell_size;
+	if (fx < 0.f || fy < 0.f || fx >= (float)m_cols || fy >= (float)m_rows)
+		return false;
+
+	int x = (int)fx;
+	int y = (int)fy;
+	float tx = fx - x;
+	float ty = fy - y;
+
+	// Bilinear distance, its partial derivatives give the push-out direction
+	float d00 = node(x, y);
+	float d10 = node(x + 1, y);
+	float d01 = node(x, y + 1);
+	float d11 = node(x + 1, y + 1);
+	float bottom = d00 + (d10 - d00) * tx;
+	float top = d01 + (d11 - d01) * tx;
+	out.distance = bottom + (top - bottom) * ty;
+
+	vec2 gradient = {
+		(d10 - d00) * (1.f - ty) + (d11 - d01) * ty,
+		(d01 - d00) * (1.f - tx) + (d11 - d10) * tx
+	};
+	const Obstacle& nearest = m_obstacles[m_nearest[(size_t)y * (m_cols + 1) + x]];
+	float length = std::sqrt(gradient.x * gradient.x + gradient.y * gradient.y);
+	if (length < 1e-6f)
+	{
+		// Flat spot (deep inside or on a ridge between two obstacles), away from the center
+		gradient = { point.x - nearest.center.x, point.y - nearest.center.y };
+		length = std::sqrt(gradient.x * gradient.x + gradient.y * gradient.y);
+		if (length < 1e-6f)
+		{
+			gradient = { 1.f, 0.f };
+			length = 1.f;
+		}
+	}
+	out.normal = { gradient.x / length, gradient.y / length };
+	out.push = nearest.push;
+	return true;
+}
+
+bool ObstacleField::empty()const
+{
+	return m_obstacles.empty();
+}
+
+float ObstacleField::exact_distance(vec2 point, int& nearest)const
+{
+	float best = FLT_MAX;
+	for (size_t o = 0; o < m_obstacles.size(); ++o)
+	{
+		const Obstacle& obstacle = m_obstacles[o];
+		float dx = point.x - obstacle.center.x;
+		float dy = point.y - obstacle.center.y;
+		float d;
+		if (obstacle.count == 0)
+		{
+			d = std::sqrt(dx * dx + dy * dy) - obstacle.radius;
+		}
+		else
+		{
+			// Convex polygon: closest edge, negative when on the inner side of every edge
+			bool inside = true;
+			float closest_sq = FLT_MAX;
+			for (size_t i = 0; i < obstacle.count; ++i)
+			{
+				vec2 a = m_hull_points[obstacle.first + i];
+				vec2 b = m_hull_points[obstacle.first + (i + 1) % obstacle.count];
+				vec2 edge = { b.x - a.x, b.y - a.y };
+				vec2 to_point = { point.x - a.x, point.y - a.y };
+				if (edge.x * to_point.y - edge.y * to_point.x < 0.f)
+					inside = false;
+
+				float length_sq = edge.x * edge.x + edge.y * edge.y;
+				float t = length_sq > 0.f ? std::max(0.f, std::min(1.f, (to_point.x * edge.x + to_point.y * edge.y) / length_sq)) : 0.f;
+				float ex = to_point.x - edge.x * t;
+				float ey = to_point.y - edge.y * t;
+				closest_sq = std::min(closest_sq, ex * ex + ey * ey);
+			}
+			d = std::sqrt(closest_sq);
+			if (inside)
+				d = -d;
+		}
+
+		if (d < best)
+		{
+			best = d;
+			nearest = (int)o;
+		}
+	}
+	return best;
+}
+
+float ObstacleField::node(int x, int y)const
+{
+	return m_distances[(size_t)y * (m_cols + 1) + x];
+}
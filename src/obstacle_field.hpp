@@ -0,0 +1,67 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// Signed distance field of the static obstacles of a level (altar portal, boxes, trunks),
+// sampled on a regular grid covering them. Built once when the obstacles are placed, after
+// which any point can be tested for penetration depth and push-out direction in constant
+// time, however many obstacles the level has.
+class ObstacleField
+{
+public:
+	explicit ObstacleField(float cell_size = 8.f);
+
+	// Drops the obstacles and the grid
+	void clear();
+
+	// Obstacles are only collected here, build() rasterizes them. push scales the response
+	// of whoever hits the obstacle and is handed back by sample().
+	void add_circle(vec2 center, float radius, float push);
+	// points is a counterclockwise convex polygon in world space, it's copied
+	void add_hull(const std::vector<vec2>& points, float push);
+
+	// Samples the distance to the closest obstacle on every grid node, the grid covers the
+	// obstacles and margin around them. Nothing can be detected farther than margin.
+	void build(float margin);
+
+	struct Sample
+	{
+		float distance; // to the closest obstacle surface, negative inside
+		vec2 normal; // unit direction to move along to get away from the obstacle
+		float push;
+	};
+
+	// False when point is outside the grid, no obstacle is close enough to matter there
+	bool sample(vec2 point, Sample& out)const;
+
+	bool empty()const;
+
+private:
+	// Circles have no points
+	struct Obstacle
+	{
+		vec2 center;
+		float radius;
+		size_t first;
+		size_t count;
+		float push;
+	};
+
+	// Exact distance to the closest obstacle, used to fill the grid
+	float exact_distance(vec2 point, int& nearest)const;
+
+	float node(int x, int y)const;
+
+	std::vector<Obstacle> m_obstacles;
+	std::vector<vec2> m_hull_points;
+	std::vector<float> m_distances; // (m_cols + 1) * (m_rows + 1) nodes
+	std::vector<uint8_t> m_nearest; // obstacle closest to each node
+	vec2 m_origin;
+	float m_cell_size;
+	int m_cols;
+	int m_rows;
+};
@@ -9,7 +9,6 @@ class particles : public Renderable
 public:
 	particles() {};
 	particles(float lifetime, float scale, vec2 position, vec2 initial_velocity);
-	~particles();
 
 	bool init(float lifetime, float scale, vec2 position, vec2 initial_velocity);
 
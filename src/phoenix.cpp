@@ -1,4 +1,6 @@
 #include "phoenix.h"
+#include "gl_state.hpp"
+#include "game_random.hpp"
 #include "FireBall.h"
 #include <algorithm>
 #include <stdlib.h>
@@ -7,6 +9,14 @@
 
 
 SpriteSheet phoenix::texture;
+
+ObjectPool<phoenix>& phoenix::pool()
+{
+	// phoenix_skill never summons more than three at once
+	static ObjectPool<phoenix> pool(3);
+	return pool;
+}
+
 phoenix::phoenix(float hp, float damage, vec2 position, vec2 scale, float angle)
 {
 	init(hp, damage, position, scale,angle);
@@ -31,60 +41,42 @@ bool phoenix::init(float hp, float damage, vec2 position, vec2 scale, float angl
 	float wr = texture.subWidth * 0.5f;
 	float hr = texture.height * 0.5f;
 
-	texVertices[0].position = { -wr, +hr, -0.01f };
-	//vertices[0].texcoord = { 0.f, 1.f };
-	texVertices[1].position = { +wr, +hr, -0.01f };
-	//vertices[1].texcoord = { 1.f, 1.f, };
-	texVertices[2].position = { +wr, -hr, -0.01f };
-	//vertices[2].texcoord = { 1.f, 0.f };
-	texVertices[3].position = { -wr, -hr, -0.01f };
-	//vertices[3].texcoord = { 0.f, 0.f };
-
-	for (int i = 0; i <= texture.totalTiles; i++) {
-		texture_locs.push_back((float)i * texture.subWidth / texture.width);
+	// Frames and clips are shared by every phoenix
+	if (texture.frames.empty())
+	{
+		texture.build_frames(texture.totalTiles);
+		texture.animations.add("summon", { 0, 5, 1000.f / 12.f, true });
+		texture.animations.add("fly", { 4, 4, 1000.f / 12.f, true });
+		texture.animations.add("death", { 8, 3, 1000.f / 12.f, false });
 	}
 
-	// counterclockwise as it's the default opengl front winding direction
-	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-	// Clearing errors
-	gl_flush_errors();
-
-	// Vertex Buffer creation
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
-
-	// Index Buffer creation
-	glGenBuffers(1, &mesh.ibo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
-
-	// Vertex Array (Container for Vertex + Index buffer)
-	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors())
+	// The quad is uploaded once, animating only moves the window sampled from the sheet
+	if (!gl_reuse_sprite_quad(mesh, wr, hr, -0.01f))
 		return false;
+	m_animation = AnimationPlayer();
+	m_animation.play(texture.animations.find("summon"));
+	setTextureLocs(m_animation.get_frame());
 
 	// Loading shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
+	if (!effect.load_from_file(shader_path("animated.vs.glsl"), shader_path("textured.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 	// Setting initial values, scale is negative to make it face the opposite way
 	// 1.0 would be as big as the original texture
 	max_hp = hp;
 	m_scale = scale;
 	m_rotation = 0;
 	m_position = position;
-	animation_time = 0.0f;
 	m_hp = hp;
-	first_time = true;
 	projectile_damage = damage;
 	particle_damage = 0.02f;
 	elapsedTime = 0.f;
 	m_angle = angle;
-	death_animation_time = 0.f;
     num_particles = 20;
     last_used_particle = 0;
 
+    // A recycled phoenix may still hold the particles of its previous summon
+    m_particles.clear();
     emit_particles();
 	return true;
 }
@@ -108,7 +100,10 @@ void phoenix::shoot_projectiles(vec2 target_position, std::vector<Projectile*> &
 {
 	vec2 shoot_direction = { target_position.x - m_position.x, target_position.y - m_position.y };
 	float angle = atan2(shoot_direction.y,shoot_direction.x);
-	Fireball* fireball = new Fireball(angle, 400.f, projectile_damage);
+	Fireball* fireball = Fireball::pool().acquire();
+	if (fireball == nullptr)
+		return;
+	fireball->init(angle, 400.f, projectile_damage);
 	fireball->set_position(m_position);
 	hero_projectiles.emplace_back(fireball);
 }
@@ -177,49 +172,18 @@ vec2 phoenix::find_target(std::vector<Enemy_01> &m_enemys_01, std::vector<Enemy_
 
 }
 
-void phoenix::destroy(bool reset)
+void phoenix::destroy()
 {
-    if (!is_alive() || reset) {
-        for (int i = 0; i < m_particles.size(); i++) {
-            m_particles[i].destroy();
-        }
-        m_particles.clear();
-		glDeleteVertexArrays(1, &mesh.vao);
-		effect.release();
-    }
-
-	glDeleteBuffers(1, &mesh.vbo);
-	glDeleteBuffers(1, &mesh.ibo);
+	for (int i = 0; i < m_particles.size(); i++) {
+		m_particles[i].destroy();
+	}
+	m_particles.clear();
+	pool().release(this);
 }
 
 void phoenix::setTextureLocs(int index)
 {
-	texVertices[0].texcoord = { texture_locs[index], 1.f }; //top left
-	texVertices[1].texcoord = { texture_locs[index + 1], 1.f }; //top right
-	texVertices[2].texcoord = { texture_locs[index + 1], 0.f }; //bottom right
-	texVertices[3].texcoord = { texture_locs[index], 0.f }; //bottom left
-
-	// counterclockwise as it's the default opengl front winding direction
-	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-	// Clearing errors
-	gl_flush_errors();
-
-	// Clear memory allocation
-	if (!first_time) {
-		destroy(false);
-	}
-
-	// Vertex Buffer creation
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
-
-	// Index Buffer creation
-	glGenBuffers(1, &mesh.ibo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
-	first_time = false;
+	m_frame = texture.get_frame(index);
 }
 
 void phoenix::emit_particles()
@@ -229,17 +193,16 @@ void phoenix::emit_particles()
     float bottom = m_position.y;
     float step_to_right = range.x / 20;
     float step_to_top = range.y / 40;
+	m_particles.reserve(m_particles.size() + num_particles);
 	for (int i = 0; i < num_particles; i++)
 	{
-		particles p;
-		float lifetime = 1.5f + (rand() % 100) / 100.f; //a slightly different lifetime for each particle
-		float scale = float(rand() % 100) / 2000.f;
-        int randomX = rand() % 10 - 5;
-        int randomY = rand() % 30 - 15;
+		float lifetime = 1.5f + (game_rand() % 100) / 100.f; //a slightly different lifetime for each particle
+		float scale = float(game_rand() % 100) / 2000.f;
+        int randomX = game_rand() % 10 - 5;
+        int randomY = game_rand() % 30 - 15;
 		vec2 initial_velocity = { 0.f,8.f };
 		vec2 position = { left + randomX*step_to_right, bottom + randomY*step_to_top };
-		p.init(lifetime, scale, position, initial_velocity);
-		m_particles.emplace_back(p);
+		m_particles.emplace_back(lifetime, scale, position, initial_velocity);
 	}
 }
 
@@ -250,10 +213,10 @@ void phoenix::respawn_particle(particles& particle)
     float bottom = m_position.y;
     float step_to_right = range.x / 20;
     float step_to_top = range.y / 40;
-    int randomX = rand() % 10 - 5;
-    int randomY = rand() % 30 - 15;
-    float lifetime = 1.5f + (rand() % 100) / 100.f; //a slightly different lifetime for each particle
-    float scale = float(rand() % 100) / 2000.f;
+    int randomX = game_rand() % 10 - 5;
+    int randomY = game_rand() % 30 - 15;
+    float lifetime = 1.5f + (game_rand() % 100) / 100.f; //a slightly different lifetime for each particle
+    float scale = float(game_rand() % 100) / 2000.f;
     vec2 initial_velocity = { 0.f,8.f };
     vec2 position = { left + randomX * step_to_right, bottom + randomY * step_to_top };
     particle.set_position(position);
@@ -291,6 +254,10 @@ void phoenix::change_hp(float d_hp)
 
 phoenix::~phoenix()
 {
+	glDeleteBuffers(1, &mesh.vbo);
+	glDeleteBuffers(1, &mesh.ibo);
+	glDeleteVertexArrays(1, &mesh.vao);
+	effect.release();
 }
 
 bool phoenix::collide_with(Enemies &enemy)
@@ -335,7 +302,7 @@ void phoenix::update(float ms, vec2 hero_position, std::vector<Enemy_01> &m_enem
     //update the state of the phoenix
     float d_hp = -ms / 1000 * 5; //Decrease hp every second
     change_hp(d_hp); //decrease some amount of hp overtime
-    float fire = float(rand() % 100);
+    float fire = float(game_rand() % 100);
     if (fire < 3.f)
     {
         attack(m_enemys_01, m_enemys_02, m_enemys_03, hero_projectiles);
@@ -382,36 +349,22 @@ void phoenix::update(float ms, vec2 hero_position, std::vector<Enemy_01> &m_enem
     }
 
 	//animation
-	float animation_speed = 0.2f;
-	animation_time += animation_speed;
-	if (elapsedTime < 500)
+	if (elapsedTime >= 500)
 	{
-		int curidx = 0;
-		int numTiles = 5;
-		curidx += (int)animation_time % numTiles;
-		setTextureLocs(curidx);
-	}
-	else if (m_hp < 0.5f)
-	{
-		death_animation_time += animation_speed;
-		int curidx = 8;
-		int numTiles = 3;
-		curidx += (int)death_animation_time % numTiles;
-		setTextureLocs(curidx);
-	}
-	else
-	{
-		int curidx = 4;
-		int numTiles = 4;
-		curidx += (int)animation_time % numTiles;
-		setTextureLocs(curidx);
+		if (m_hp < 0.5f)
+			m_animation.play(texture.animations.find("death"));
+		else
+			m_animation.play(texture.animations.find("fly"));
 	}
+	m_animation.update(ms);
+	setTextureLocs(m_animation.get_frame());
 	elapsedTime += ms;
 }
 
 bool phoenix::is_alive()
 {
-	return m_hp > 0.5f || death_animation_time < 3;
+	// Stays around until the death clip has been played through
+	return m_hp > 0.5f || !m_animation.is_finished();
 }
 
 
@@ -426,39 +379,31 @@ void phoenix::draw(const mat3 &projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint uv_offset_uloc = effect.locations->uv_offset;
+	GLint uv_scale_uloc = effect.locations->uv_scale;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture.id);
+	GLState::instance().bind_texture(0, texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
 	float color[] = { 1.f, 1.f, 1.f };
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
+	m_frame.set_uniforms(uv_offset_uloc, uv_scale_uloc);
 
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
@@ -466,4 +411,9 @@ void phoenix::draw(const mat3 &projection)
     for (int i = 0; i < num_particles; i++) {
         m_particles[i].draw(projection);
     }
+}
+
+GLuint phoenix::get_texture_id()const
+{
+	return texture.id;
 }
\ No newline at end of file
@@ -7,11 +7,15 @@
 #include "enemy_01.hpp"
 #include "enemy_02.hpp"
 #include "enemy_03.hpp"
+#include "object_pool.hpp"
 
 class phoenix : public Renderable
 {
 	static SpriteSheet texture;
 public:
+	// Shared by every phoenix, destroy() hands a phoenix back
+	static ObjectPool<phoenix>& pool();
+
 	phoenix() {};
 	phoenix(float hp, float damage,vec2 position,vec2 scale,float angle);
 	~phoenix();
@@ -30,11 +34,14 @@ public:
 
 	void draw(const mat3 &projection);
 
+	GLuint get_texture_id()const;
+
 	bool collide_with(Enemies &e);
 
 	bool collide_with(Projectile & p);
 
-	void destroy(bool reset);
+	// Returns the phoenix to the pool, its buffers are kept for the next summon
+	void destroy();
 
 	void shoot_projectiles(vec2 target_position, std::vector<Projectile*> & hero_projectiles);
 
@@ -63,11 +70,8 @@ protected:
 	vec2 m_scale;
 	float m_rotation;
 	float speed;
-	float animation_time;
-	float death_animation_time;
-	TexturedVertex texVertices[4];
-	std::vector<float> texture_locs;
-	bool first_time;
+	SpriteFrame m_frame; // part of the sprite sheet currently displayed
+	AnimationPlayer m_animation;
 	std::vector<particles> m_particles;
     int num_particles;
     int last_used_particle;
@@ -26,7 +26,10 @@ float phoenix_skill::create_phoenix(std::vector<phoenix*> &phoenix_list,vec2 her
 		float dx = cos(angle) * radius;
 		float dy = sin(angle) * radius;
 		vec2 position = { hero_position.x + dx, hero_position.y + dy };
-		phoenix* p = new phoenix(m_hp, damage, position, m_scale, angle);
+		phoenix* p = phoenix::pool().acquire();
+		if (p == nullptr)
+			return 0.f;
+		p->init(m_hp, damage, position, m_scale, angle);
 		Mix_PlayChannel(-1, m_phoenix_sound, 0);
 		phoenix_list.emplace_back(p);
 	}
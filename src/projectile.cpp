@@ -35,10 +35,17 @@ vec2 Projectile::get_velocity() const{
 
 void Projectile::destroy()
 {
-	glDeleteBuffers(1, &mesh.vbo);
-    glDeleteBuffers(1, &mesh.ibo);
+    // Projectiles are drawn through the SpriteBatch and own no GPU resources
+}
 
-    effect.release();
+void Projectile::mark_removed()
+{
+    m_removed = true;
+}
+
+bool Projectile::is_removed() const
+{
+    return m_removed;
 }
 
 void Projectile::set_scale(vec2 scale){
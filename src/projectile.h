@@ -45,6 +45,13 @@ public:
 
     void set_scale(vec2 scale);
 
+    // Flags the projectile as spent, World destroys it and drops it at the end of the tick
+    void mark_removed();
+
+    bool is_removed() const;
+
+    PreviousPosition previous_position; // for drawing between simulation steps
+
 protected:
     vec2 m_position; // Window coordinates
     vec2 m_scale; // 1.f in each dimension. 1.f is as big as the associated texture
@@ -52,6 +59,7 @@ protected:
     vec2 velocity;
     float initial_speed;
     float damage;
+    bool m_removed = false;
 
 };
 
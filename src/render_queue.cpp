@@ -0,0 +1,104 @@
+// Header
+#include "render_queue.hpp"
+#include "sprite_batch.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const int LAYER_SHIFT = 56;
+	const int DEPTH_SHIFT = 40;
+	const int PROGRAM_SHIFT = 24;
+	const uint64_t DEPTH_MASK = 0xFFFF;
+	const uint64_t PROGRAM_MASK = 0xFFFF;
+	const uint64_t TEXTURE_MASK = 0xFFFFFF;
+}
+
+RenderQueue& RenderQueue::instance()
+{
+	static RenderQueue queue;
+	return queue;
+}
+
+RenderQueue::RenderQueue() :
+	m_view_min({ 0.f, 0.f }),
+	m_view_max({ 0.f, 0.f }),
+	m_command_count(0),
+	m_culled(0),
+	m_culled_count(0)
+{
+}
+
+void RenderQueue::set_view(vec2 view_min, vec2 view_max)
+{
+	m_view_min = view_min;
+	m_view_max = view_max;
+}
+
+void RenderQueue::submit(Renderable& renderable, Layer layer, float depth)
+{
+	Command command;
+	command.key = make_key(layer, depth, renderable.effect.program, renderable.get_texture_id());
+	command.renderable = &renderable;
+	m_commands.push_back(command);
+}
+
+bool RenderQueue::submit(Renderable& renderable, Layer layer, vec2 center, vec2 size, float depth)
+{
+	// Half the diagonal bounds the box whatever its rotation
+	float radius = 0.5f * sqrtf(size.x * size.x + size.y * size.y);
+	if (center.x + radius < m_view_min.x || center.x - radius > m_view_max.x ||
+		center.y + radius < m_view_min.y || center.y - radius > m_view_max.y)
+	{
+		++m_culled;
+		return false;
+	}
+
+	submit(renderable, layer, depth);
+	return true;
+}
+
+void RenderQueue::flush(const mat3& projection)
+{
+	// Stable so entities sharing a key are still drawn in the order they were submitted
+	std::stable_sort(m_commands.begin(), m_commands.end(), [](const Command& a, const Command& b) {
+		return a.key < b.key;
+	});
+
+	for (size_t i = 0; i < m_commands.size(); ++i)
+	{
+		if (i > 0 && (m_commands[i].key >> LAYER_SHIFT) != (m_commands[i - 1].key >> LAYER_SHIFT))
+			SpriteBatch::instance().flush();
+		m_commands[i].renderable->draw(projection);
+	}
+	SpriteBatch::instance().flush();
+
+	m_command_count = (int)m_commands.size();
+	m_culled_count = m_culled;
+	m_commands.clear();
+	m_culled = 0;
+}
+
+int RenderQueue::get_command_count()const
+{
+	return m_command_count;
+}
+
+int RenderQueue::get_culled_count()const
+{
+	return m_culled_count;
+}
+
+uint64_t RenderQueue::make_key(Layer layer, float depth, GLuint program, GLuint texture)
+{
+	// Deeper commands get a smaller key so they are drawn first
+	depth = std::min(std::max(depth, 0.f), 1.f);
+	uint64_t inverted_depth = (uint64_t)((1.f - depth) * DEPTH_MASK);
+
+	return ((uint64_t)layer << LAYER_SHIFT) |
+		((inverted_depth & DEPTH_MASK) << DEPTH_SHIFT) |
+		(((uint64_t)program & PROGRAM_MASK) << PROGRAM_SHIFT) |
+		((uint64_t)texture & TEXTURE_MASK);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// Collects the world's draw calls for a frame and submits them ordered by a 64-bit sort key
+// (layer, depth, program, texture). Layering comes from the key instead of from the order
+// World happens to call draw(), which leaves the queue free to put every draw sharing a
+// shader and texture next to each other.
+class RenderQueue
+{
+public:
+	// Coarse draw order, lower layers end up below higher ones
+	enum Layer
+	{
+		LAYER_BACKGROUND = 0,
+		LAYER_ACTORS,
+		LAYER_PROJECTILES,
+		LAYER_EFFECTS,
+		LAYER_SCENERY,
+		LAYER_SUMMONS,
+		LAYER_COUNT
+	};
+
+	static RenderQueue& instance();
+
+	// Camera rectangle in world coordinates, used to cull the submissions that carry bounds
+	void set_view(vec2 view_min, vec2 view_max);
+
+	// Queues renderable. Within a layer, a higher depth in [0, 1] is drawn first, commands
+	// with equal depth are grouped by program then texture and keep their submission order.
+	void submit(Renderable& renderable, Layer layer, float depth = 0.f);
+
+	// Same as above for a renderable centered on center with a bounding box of size.
+	// Returns false and queues nothing if it cannot overlap the view at any rotation.
+	bool submit(Renderable& renderable, Layer layer, vec2 center, vec2 size, float depth = 0.f);
+
+	// Sorts the queued commands and draws them. Sprites queued into the SpriteBatch by a
+	// layer are flushed before the next layer starts, so batched draws keep their layer too.
+	void flush(const mat3& projection);
+
+	// Commands drawn by the last flush, and bounded submissions culled before it
+	int get_command_count()const;
+	int get_culled_count()const;
+
+	// Layer in bits 56-63, inverted depth in 40-55, program in 24-39 and texture in 0-23
+	static uint64_t make_key(Layer layer, float depth, GLuint program, GLuint texture);
+
+private:
+	RenderQueue();
+	RenderQueue(const RenderQueue&) = delete;
+	RenderQueue& operator=(const RenderQueue&) = delete;
+
+	struct Command
+	{
+		uint64_t key;
+		Renderable* renderable;
+	};
+
+	std::vector<Command> m_commands;
+	vec2 m_view_min;
+	vec2 m_view_max;
+	int m_command_count;
+	int m_culled;
+	int m_culled_count;
+};
@@ -0,0 +1,263 @@
+// Header
+#include "replay.hpp"
+
+// stlib
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+	const char MAGIC[4] = { 'M', 'C', 'R', 'P' };
+	const uint8_t VERSION = 1;
+
+	// Walks the loaded file, every read fails once the data runs out
+	struct Reader
+	{
+		const std::vector<char>& data;
+		size_t offset;
+
+		bool read_bytes(void* out, size_t size)
+		{
+			if (data.size() - offset < size)
+				return false;
+			memcpy(out, data.data() + offset, size);
+			offset += size;
+			return true;
+		}
+
+		template <typename T>
+		bool read_raw(T& out)
+		{
+			return read_bytes(&out, sizeof(T));
+		}
+
+		bool read_varint(uint32_t& out)
+		{
+			out = 0;
+			for (int shift = 0; shift < 35; shift += 7)
+			{
+				uint8_t byte;
+				if (!read_raw(byte))
+					return false;
+				out |= (uint32_t)(byte & 0x7f) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		bool read_int(int& out)
+		{
+			uint32_t zigzag;
+			if (!read_varint(zigzag))
+				return false;
+			out = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+			return true;
+		}
+
+		bool at_end()const
+		{
+			return offset == data.size();
+		}
+	};
+
+	bool read_event(Reader& reader, uint32_t& tick, InputEvent& event)
+	{
+		uint32_t delta;
+		uint8_t type;
+		if (!reader.read_varint(delta) || !reader.read_raw(type) || type > InputEvent::END)
+			return false;
+
+		tick += delta;
+		event = InputEvent();
+		event.tick = tick;
+		event.type = (InputEvent::Type)type;
+
+		uint8_t action, mods;
+		switch (event.type)
+		{
+		case InputEvent::KEY:
+			if (!reader.read_int(event.code) || !reader.read_int(event.scancode) || !reader.read_raw(action) || !reader.read_raw(mods))
+				return false;
+			event.action = action;
+			event.mods = mods;
+			return true;
+		case InputEvent::MOUSE_BUTTON:
+			if (!reader.read_int(event.code) || !reader.read_raw(action) || !reader.read_raw(mods))
+				return false;
+			event.action = action;
+			event.mods = mods;
+			return true;
+		case InputEvent::MOUSE_MOVE:
+		case InputEvent::MOUSE_WHEEL:
+			return reader.read_raw(event.x) && reader.read_raw(event.y);
+		default:
+			return true;
+		}
+	}
+}
+
+ReplayRecorder::ReplayRecorder() :
+	m_last_tick(0)
+{
+}
+
+bool ReplayRecorder::init(const char* path, const ReplayHeader& header)
+{
+	m_file.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open())
+	{
+		fprintf(stderr, "Failed to create replay %s\n", path);
+		return false;
+	}
+
+	m_file.write(MAGIC, sizeof(MAGIC));
+	write_raw(VERSION);
+	write_raw(header.rand_seed);
+	write_raw(header.rng_seed);
+	write_raw(header.step_ms);
+	write_raw(header.screen_width);
+	write_raw(header.screen_height);
+	write_varint((uint32_t)header.shop_state.size());
+	m_file.write(header.shop_state.data(), header.shop_state.size());
+	m_last_tick = 0;
+	return m_file.good();
+}
+
+void ReplayRecorder::destroy(uint32_t end_tick)
+{
+	if (!is_recording())
+		return;
+
+	InputEvent end = InputEvent();
+	end.tick = end_tick;
+	end.type = InputEvent::END;
+	record(end);
+	m_file.close();
+}
+
+bool ReplayRecorder::is_recording()const
+{
+	return m_file.is_open();
+}
+
+void ReplayRecorder::record(const InputEvent& event)
+{
+	write_varint(event.tick - m_last_tick);
+	write_raw((uint8_t)event.type);
+	m_last_tick = event.tick;
+
+	switch (event.type)
+	{
+	case InputEvent::KEY:
+		write_int(event.code);
+		write_int(event.scancode);
+		write_raw((uint8_t)event.action);
+		write_raw((uint8_t)event.mods);
+		break;
+	case InputEvent::MOUSE_BUTTON:
+		write_int(event.code);
+		write_raw((uint8_t)event.action);
+		write_raw((uint8_t)event.mods);
+		break;
+	case InputEvent::MOUSE_MOVE:
+	case InputEvent::MOUSE_WHEEL:
+		// Full precision, the hero aims with the exact cursor position
+		write_raw(event.x);
+		write_raw(event.y);
+		break;
+	default:
+		break;
+	}
+}
+
+void ReplayRecorder::write_varint(uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		write_raw((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	write_raw((uint8_t)value);
+}
+
+void ReplayRecorder::write_int(int value)
+{
+	write_varint(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+ReplayPlayer::ReplayPlayer() :
+	m_next(0),
+	m_end_tick(0),
+	m_playing(false)
+{
+}
+
+bool ReplayPlayer::init(const char* path, ReplayHeader& header)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		fprintf(stderr, "Failed to open replay %s\n", path);
+		return false;
+	}
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	Reader reader = { data, 0 };
+
+	char magic[sizeof(MAGIC)];
+	uint8_t version;
+	uint32_t shop_size;
+	if (!reader.read_bytes(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+		!reader.read_raw(version) || version != VERSION)
+	{
+		fprintf(stderr, "%s is not a replay of this version\n", path);
+		return false;
+	}
+	if (!reader.read_raw(header.rand_seed) || !reader.read_raw(header.rng_seed) || !reader.read_raw(header.step_ms) ||
+		!reader.read_raw(header.screen_width) || !reader.read_raw(header.screen_height) ||
+		!reader.read_varint(shop_size) || data.size() - reader.offset < shop_size)
+	{
+		fprintf(stderr, "Replay %s has a truncated header\n", path);
+		return false;
+	}
+	header.shop_state.assign(data.data() + reader.offset, shop_size);
+	reader.offset += shop_size;
+
+	// A session cut short (crash, killed process) has no END, play whatever made it to disk
+	m_events.clear();
+	uint32_t tick = 0;
+	InputEvent event;
+	while (!reader.at_end() && read_event(reader, tick, event) && event.type != InputEvent::END)
+		m_events.push_back(event);
+	m_end_tick = tick;
+	m_next = 0;
+	m_playing = true;
+	return true;
+}
+
+void ReplayPlayer::destroy()
+{
+	m_events.clear();
+	m_next = 0;
+	m_end_tick = 0;
+	m_playing = false;
+}
+
+bool ReplayPlayer::is_playing()const
+{
+	return m_playing;
+}
+
+bool ReplayPlayer::next(uint32_t tick, InputEvent& out)
+{
+	if (m_next == m_events.size() || m_events[m_next].tick > tick)
+		return false;
+	out = m_events[m_next++];
+	return true;
+}
+
+bool ReplayPlayer::is_finished(uint32_t tick)const
+{
+	return m_playing && m_next == m_events.size() && tick >= m_end_tick;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// One input callback as World received it. tick is the number of World::update calls
+// made before it arrived, which is where playback delivers it again.
+struct InputEvent
+{
+	enum Type : uint8_t { KEY, MOUSE_MOVE, MOUSE_BUTTON, MOUSE_WHEEL, END };
+
+	uint32_t tick;
+	Type type;
+	int code;   // key or mouse button
+	int scancode;
+	int action;
+	int mods;
+	double x, y; // cursor position or wheel offsets
+};
+
+// Everything besides the input that decides how a session plays out
+struct ReplayHeader
+{
+	uint32_t rand_seed; // game_srand()
+	uint32_t rng_seed;  // World's spawn generator
+	float step_ms;      // fixed simulation step the session ran at
+	int32_t screen_width;
+	int32_t screen_height;
+	std::string shop_state; // serialized Shop::shop_info at the start
+};
+
+// Writes a session to a compact binary file: the header, then every event as a varint tick
+// delta, a type byte and only the fields that type uses. Events are streamed as they come,
+// destroy() closes the file with an END marker holding the length of the session.
+class ReplayRecorder
+{
+public:
+	ReplayRecorder();
+
+	// Creates path and writes the header, false if the file can't be opened
+	bool init(const char* path, const ReplayHeader& header);
+
+	// Terminates the file with the tick the session ended on
+	void destroy(uint32_t end_tick);
+
+	bool is_recording()const;
+
+	void record(const InputEvent& event);
+
+private:
+	// Unsigned LEB128, ints are zigzag encoded first so small negatives stay small
+	void write_varint(uint32_t value);
+	void write_int(int value);
+
+	// Plain little endian copy of fixed size fields
+	template <typename T>
+	void write_raw(const T& value)
+	{
+		m_file.write((const char*)&value, sizeof(T));
+	}
+
+	std::ofstream m_file;
+	uint32_t m_last_tick;
+};
+
+// Reads a file written by ReplayRecorder and hands the events back tick by tick
+class ReplayPlayer
+{
+public:
+	ReplayPlayer();
+
+	// Loads the whole file, false with a message if it is missing or malformed
+	bool init(const char* path, ReplayHeader& header);
+
+	void destroy();
+
+	bool is_playing()const;
+
+	// Pops the next event recorded for the given tick, false once there are none left for it
+	bool next(uint32_t tick, InputEvent& out);
+
+	// True once the session has been played up to the tick it ended on
+	bool is_finished(uint32_t tick)const;
+
+private:
+	std::vector<InputEvent> m_events;
+	size_t m_next;
+	uint32_t m_end_tick;
+	bool m_playing;
+};
@@ -0,0 +1,227 @@
+// Header
+#include "shader_registry.hpp"
+#include "headless_gl.hpp"
+
+// stlib
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+	bool gl_compile_shader(GLuint shader)
+	{
+		glCompileShader(shader);
+		GLint success = 0;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+		if (success == GL_FALSE)
+		{
+			GLint log_len;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_len);
+			std::vector<char> log(log_len);
+			glGetShaderInfoLog(shader, log_len, &log_len, log.data());
+			glDeleteShader(shader);
+
+			fprintf(stderr, "GLSL: %s", log.data());
+			return false;
+		}
+
+		return true;
+	}
+
+	void gl_delete_program(GLuint program, GLuint vertex, GLuint fragment)
+	{
+		glDetachShader(program, vertex);
+		glDeleteShader(vertex);
+		glDetachShader(program, fragment);
+		glDeleteShader(fragment);
+		glDeleteProgram(program);
+	}
+}
+
+ShaderRegistry& ShaderRegistry::instance()
+{
+	static ShaderRegistry registry;
+	return registry;
+}
+
+bool ShaderRegistry::acquire(const char* vs_path, const char* fs_path, Effect& effect)
+{
+	Key key(vs_path, fs_path);
+	auto it = m_programs.find(key);
+	if (it == m_programs.end())
+	{
+		Program program;
+		if (!build(vs_path, fs_path, program))
+			return false;
+		program.ref_count = 0;
+		it = m_programs.insert(std::make_pair(key, program)).first;
+	}
+
+	Program& program = it->second;
+	++program.ref_count;
+	effect.vertex = program.vertex;
+	effect.fragment = program.fragment;
+	effect.program = program.program;
+	effect.locations = &program.locations;
+	return true;
+}
+
+void ShaderRegistry::release(Effect& effect)
+{
+	if (effect.program == 0)
+		return;
+
+	// Only a handful of programs exist, a linear scan is cheaper than a second index
+	for (auto it = m_programs.begin(); it != m_programs.end(); ++it)
+	{
+		Program& program = it->second;
+		if (program.program != effect.program)
+			continue;
+
+		if (--program.ref_count <= 0)
+		{
+			gl_delete_program(program.program, program.vertex, program.fragment);
+			m_programs.erase(it);
+		}
+		break;
+	}
+
+	effect.vertex = 0;
+	effect.fragment = 0;
+	effect.program = 0;
+	effect.locations = nullptr;
+}
+
+size_t ShaderRegistry::size()const
+{
+	return m_programs.size();
+}
+
+bool ShaderRegistry::build(const char* vs_path, const char* fs_path, Program& out)
+{
+	// Nothing is drawn, a program name without sources or locations is enough
+	if (is_headless_gl())
+	{
+		out.vertex = glCreateShader(GL_VERTEX_SHADER);
+		out.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+		out.program = glCreateProgram();
+		return true;
+	}
+
+	gl_flush_errors();
+
+	// Opening files
+	std::ifstream vs_is(vs_path);
+	std::ifstream fs_is(fs_path);
+
+	if (!vs_is.good() || !fs_is.good())
+	{
+		fprintf(stderr, "Failed to load shader files %s, %s", vs_path, fs_path);
+		return false;
+	}
+
+	// Reading sources
+	std::stringstream vs_ss, fs_ss;
+	vs_ss << vs_is.rdbuf();
+	fs_ss << fs_is.rdbuf();
+	std::string vs_str = vs_ss.str();
+	std::string fs_str = fs_ss.str();
+	const char* vs_src = vs_str.c_str();
+	const char* fs_src = fs_str.c_str();
+	GLsizei vs_len = (GLsizei)vs_str.size();
+	GLsizei fs_len = (GLsizei)fs_str.size();
+
+	out.vertex = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(out.vertex, 1, &vs_src, &vs_len);
+	out.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(out.fragment, 1, &fs_src, &fs_len);
+
+	// Compiling
+	// Shaders already delete if compilation fails
+	if (!gl_compile_shader(out.vertex))
+	{
+		glDeleteShader(out.fragment);
+		return false;
+	}
+
+	if (!gl_compile_shader(out.fragment))
+	{
+		glDeleteShader(out.vertex);
+		return false;
+	}
+
+	// Linking
+	out.program = glCreateProgram();
+	glAttachShader(out.program, out.vertex);
+	glAttachShader(out.program, out.fragment);
+	glLinkProgram(out.program);
+	{
+		GLint is_linked = 0;
+		glGetProgramiv(out.program, GL_LINK_STATUS, &is_linked);
+		if (is_linked == GL_FALSE)
+		{
+			GLint log_len;
+			glGetProgramiv(out.program, GL_INFO_LOG_LENGTH, &log_len);
+			std::vector<char> log(log_len);
+			glGetProgramInfoLog(out.program, log_len, &log_len, log.data());
+
+			gl_delete_program(out.program, out.vertex, out.fragment);
+			fprintf(stderr, "Link error: %s", log.data());
+			return false;
+		}
+	}
+
+	if (gl_has_errors())
+	{
+		gl_delete_program(out.program, out.vertex, out.fragment);
+		fprintf(stderr, "OpenGL errors occured while compiling Effect");
+		return false;
+	}
+
+	reflect(out.program, out.locations);
+	return true;
+}
+
+void ShaderRegistry::reflect(GLuint program, ShaderLocations& out)
+{
+	GLint count = 0;
+	GLint max_length = 0;
+	GLint size;
+	GLenum type;
+
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+	std::vector<char> name(std::max(max_length, 1));
+	for (GLint i = 0; i < count; ++i)
+	{
+		glGetActiveUniform(program, (GLuint)i, (GLsizei)name.size(), nullptr, &size, &type, name.data());
+		std::string uniform = name.data();
+		GLint location = glGetUniformLocation(program, uniform.c_str());
+
+		// Arrays are reported as "name[0]", store them under their plain name
+		size_t bracket = uniform.find('[');
+		if (bracket != std::string::npos)
+			uniform.erase(bracket);
+		out.uniforms[uniform] = location;
+	}
+
+	glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+	glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length);
+	name.assign(std::max(max_length, 1), '\0');
+	for (GLint i = 0; i < count; ++i)
+	{
+		glGetActiveAttrib(program, (GLuint)i, (GLsizei)name.size(), nullptr, &size, &type, name.data());
+		out.attributes[name.data()] = glGetAttribLocation(program, name.data());
+	}
+
+	out.transform = out.get_uniform("transform");
+	out.projection = out.get_uniform("projection");
+	out.fcolor = out.get_uniform("fcolor");
+	out.light_up = out.get_uniform("light_up");
+	out.time = out.get_uniform("time");
+	out.uv_offset = out.get_uniform("uv_offset");
+	out.uv_scale = out.get_uniform("uv_scale");
+	out.in_position = out.get_attribute("in_position");
+	out.in_texcoord = out.get_attribute("in_texcoord");
+	out.in_color = out.get_attribute("in_color");
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <map>
+#include <string>
+#include <utility>
+
+// Process-wide cache of linked shader programs, keyed by their (vertex, fragment) paths.
+// An Effect is only a handle into it: the first Effect asking for a pair compiles and
+// links it, everybody after that shares the same program. Programs are reference counted
+// and deleted once the last Effect using them is released.
+class ShaderRegistry
+{
+public:
+	static ShaderRegistry& instance();
+
+	// Points effect at the program built from vs_path and fs_path, compiling it on first use
+	bool acquire(const char* vs_path, const char* fs_path, Effect& effect);
+
+	// Drops the reference held by effect and clears the handle
+	void release(Effect& effect);
+
+	// Number of distinct programs currently alive
+	size_t size()const;
+
+private:
+	ShaderRegistry() {}
+	ShaderRegistry(const ShaderRegistry&) = delete;
+	ShaderRegistry& operator=(const ShaderRegistry&) = delete;
+
+	struct Program
+	{
+		GLuint vertex;
+		GLuint fragment;
+		GLuint program;
+		ShaderLocations locations;
+		int ref_count;
+	};
+
+	typedef std::pair<std::string, std::string> Key;
+
+	// Reads, compiles and links a program, returns false and cleans up on failure
+	static bool build(const char* vs_path, const char* fs_path, Program& out);
+
+	// Queries every active uniform and attribute of a linked program
+	static void reflect(GLuint program, ShaderLocations& out);
+
+	std::map<Key, Program> m_programs;
+};
@@ -1,4 +1,5 @@
 #include "skill_switch_UI.hpp"
+#include "gl_state.hpp"
 
 #include <gl3w.h>
 
@@ -29,33 +30,25 @@ bool SkillSwitch::init(vec2 position)
 	float wr = skill_texture.subWidth * 0.5f;
 	float hr = skill_texture.height * 0.5f;
 
-	texVertices[0].position = { -wr, +hr, -0.02f };
-	texVertices[1].position = { +wr, +hr, -0.02f };
-	texVertices[2].position = { +wr, -hr, -0.02f };
-	texVertices[3].position = { -wr, -hr, -0.02f };
-	m_is_in_use = false;
+	// Frames are shared by every SkillSwitch
+	if (skill_texture.frames.empty())
+		skill_texture.build_frames(skill_texture.totalTiles);
 
-	for (int i = 0; i <= skill_texture.totalTiles; i++) {
-		texture_locs.push_back((float)i * skill_texture.subWidth / skill_texture.width);
+	// The quad is uploaded once, animating only moves the window sampled from the sheet
+	if (!gl_create_sprite_quad(mesh, wr, hr, -0.02f)) {
+		fprintf(stderr, "skillswitch sprite quad creation has error!");
+		return false;
 	}
-
-	glGenBuffers(1, &mesh.vbo);
-	glGenBuffers(1, &mesh.ibo);
+	m_is_in_use = false;
 	setTextureLocs(ICEBLADES);
 	currIndex = ICEBLADES;
 
-	// Vertex Array (Container for Vertex + Index buffer)
-	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors()) {
-		fprintf(stderr, "skillswitch glGenVertexArrays has error!");
-		return false;
-	}
-
 	// Loading shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl"))) {
+	if (!effect.load_from_file(shader_path("animated.vs.glsl"), shader_path("textured.fs.glsl"))) {
 		fprintf(stderr, "skillswitch shaders not loaded!");
 		return false;
 	}
+	gl_capture_textured_layout(mesh, effect);
 
 	// Set properties here! In future
 	m_is_in_use = true;
@@ -75,13 +68,8 @@ void SkillSwitch::destroy(bool reset)
 	glDeleteBuffers(1, &mesh.vbo);
 	glDeleteBuffers(1, &mesh.ibo);
 
-	glDeleteShader(effect.vertex);
-	glDeleteShader(effect.fragment);
-	glDeleteShader(effect.program);
-
 	if(reset) {
-		glDetachShader(effect.program, effect.vertex);
-		glDetachShader(effect.program, effect.fragment);
+		effect.release();
 	}
 }
 
@@ -93,33 +81,24 @@ void SkillSwitch::draw(const mat3& projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
-
-	// Setting texVertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint uv_offset_uloc = effect.locations->uv_offset;
+	GLint uv_scale_uloc = effect.locations->uv_scale;
+
+	// Setting vertices and indices
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, skill_texture.id);
+	GLState::instance().bind_texture(0, skill_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
@@ -127,6 +106,7 @@ void SkillSwitch::draw(const mat3& projection)
 	float color[] = { 1.f, 1.f, 1.f };
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
+	m_frame.set_uniforms(uv_offset_uloc, uv_scale_uloc);
 
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
@@ -209,32 +189,7 @@ void SkillSwitch::transitionHelper() {
 }
 
 void SkillSwitch::setTextureLocs(int index) {
-
-	texVertices[0].texcoord = { texture_locs[index], 1.f }; //top left
-	texVertices[1].texcoord = { texture_locs[index + 1], 1.f }; //top right
-	texVertices[2].texcoord = { texture_locs[index + 1], 0.f }; //bottom right
-	texVertices[3].texcoord = { texture_locs[index], 0.f }; //bottom left
-
-	// counterclockwise as it's the default opengl front winding direction
-	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
-
-	// Clearing errors
-	gl_flush_errors();
-
-	// Clear Memory
-	if (m_is_in_use) {
-		destroy(false);
-	}
-
-	// Vertex Buffer creation
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, texVertices, GL_STATIC_DRAW);
-
-	// Index Buffer creation
-	glGenBuffers(1, &mesh.ibo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
+	m_frame = skill_texture.get_frame(index);
 }
 
 void SkillSwitch::set_position(vec2 position)
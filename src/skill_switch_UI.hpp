@@ -38,9 +38,7 @@ private:
 
 	clock_t timePassed;
 
-	TexturedVertex texVertices[4];
-
-	std::vector<float> texture_locs;
+	SpriteFrame m_frame; // part of the sprite sheet currently displayed
 
 	CurrentSkillState m_skillState;
 
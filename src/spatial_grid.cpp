@@ -0,0 +1,121 @@
+// Header
+#include "spatial_grid.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+SpatialGrid::SpatialGrid(float cell_size) :
+	m_query(0),
+	m_cell_size(cell_size),
+	m_count(0)
+{
+}
+
+void SpatialGrid::clear()
+{
+	// Emptying the cells instead of the map keeps their allocations for the next tick
+	for (auto& cell : m_cells)
+		cell.second.clear();
+	m_count = 0;
+}
+
+void SpatialGrid::set_cell_size(float cell_size)
+{
+	m_cells.clear();
+	m_cell_size = cell_size;
+	m_count = 0;
+}
+
+void SpatialGrid::insert(int id, vec2 center, float radius)
+{
+	int min_x = cell_coord(center.x - radius);
+	int max_x = cell_coord(center.x + radius);
+	int min_y = cell_coord(center.y - radius);
+	int max_y = cell_coord(center.y + radius);
+	for (int y = min_y; y <= max_y; ++y)
+		for (int x = min_x; x <= max_x; ++x)
+			m_cells[cell_key(x, y)].push_back(id);
+
+	if (id >= (int)m_stamps.size())
+		m_stamps.resize(id + 1, 0u);
+	++m_count;
+}
+
+void SpatialGrid::query(vec2 center, float radius, std::vector<int>& out)
+{
+	out.clear();
+	if (m_count == 0)
+		return;
+
+	// A new stamp marks the ids already reported by this query
+	if (++m_query == 0)
+	{
+		std::fill(m_stamps.begin(), m_stamps.end(), 0u);
+		m_query = 1;
+	}
+
+	int min_x = cell_coord(center.x - radius);
+	int max_x = cell_coord(center.x + radius);
+	int min_y = cell_coord(center.y - radius);
+	int max_y = cell_coord(center.y + radius);
+	for (int y = min_y; y <= max_y; ++y)
+	{
+		for (int x = min_x; x <= max_x; ++x)
+		{
+			auto it = m_cells.find(cell_key(x, y));
+			if (it == m_cells.end())
+				continue;
+
+			for (int id : it->second)
+			{
+				if (m_stamps[id] == m_query)
+					continue;
+				m_stamps[id] = m_query;
+				out.push_back(id);
+			}
+		}
+	}
+
+	std::sort(out.begin(), out.end(), std::greater<int>());
+}
+
+void SpatialGrid::query_shared(vec2 center, float radius, std::vector<int>& out)const
+{
+	out.clear();
+	if (m_count == 0)
+		return;
+
+	int min_x = cell_coord(center.x - radius);
+	int max_x = cell_coord(center.x + radius);
+	int min_y = cell_coord(center.y - radius);
+	int max_y = cell_coord(center.y + radius);
+	for (int y = min_y; y <= max_y; ++y)
+	{
+		for (int x = min_x; x <= max_x; ++x)
+		{
+			auto it = m_cells.find(cell_key(x, y));
+			if (it != m_cells.end())
+				out.insert(out.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	std::sort(out.begin(), out.end(), std::greater<int>());
+	out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+int SpatialGrid::size()const
+{
+	return m_count;
+}
+
+uint64_t SpatialGrid::cell_key(int x, int y)const
+{
+	return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+
+int SpatialGrid::cell_coord(float v)const
+{
+	return (int)std::floor(v / m_cell_size);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid broadphase hashed on cell coordinates, so it works for any position without
+// knowing the world bounds up front. Entries are plain ids (usually indices into an entity
+// vector) inserted with a bounding circle; a query returns every id sharing a cell with the
+// query circle. It only narrows the candidates, callers still run their exact test on them.
+// Meant to be cleared and refilled every tick, cells keep their storage between ticks.
+class SpatialGrid
+{
+public:
+	explicit SpatialGrid(float cell_size = 64.f);
+
+	// Drops every entry, the cell size can only change while the grid is empty
+	void clear();
+	void set_cell_size(float cell_size);
+
+	// Adds id to every cell overlapped by the bounding box of the circle
+	void insert(int id, vec2 center, float radius);
+
+	// Fills out with the ids found in the cells overlapped by the circle, each id once and
+	// in decreasing order so callers keep the back to front order of the old entity loops
+	void query(vec2 center, float radius, std::vector<int>& out);
+
+	// Same result as query() but leaves the grid untouched, so several threads can query a
+	// grid nobody is inserting into. Duplicates are sorted out instead of stamped.
+	void query_shared(vec2 center, float radius, std::vector<int>& out)const;
+
+	// Entries inserted since the last clear()
+	int size()const;
+
+private:
+	// Cell coordinates packed in 64 bits, x in the high half
+	uint64_t cell_key(int x, int y)const;
+	int cell_coord(float v)const;
+
+	std::unordered_map<uint64_t, std::vector<int>> m_cells;
+	// Query stamp per id, avoids sorting out duplicates of entries spanning several cells
+	std::vector<unsigned> m_stamps;
+	unsigned m_query;
+	float m_cell_size;
+	int m_count;
+};
@@ -0,0 +1,227 @@
+// Header
+#include "sprite_batch.hpp"
+#include "gl_state.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace
+{
+	// Attribute slots, must match the layout qualifiers in sprite_batch.vs.glsl
+	const GLuint CORNER_LOC = 0;
+	const GLuint TRANSFORM_LOC = 1; // takes 3 slots, one per column
+	const GLuint SIZE_LOC = 4;
+	const GLuint UV_MIN_LOC = 5;
+	const GLuint UV_MAX_LOC = 6;
+	const GLuint TINT_LOC = 7;
+	const GLuint DEPTH_LOC = 8;
+
+	const size_t INITIAL_CAPACITY = 256;
+}
+
+SpriteBatch& SpriteBatch::instance()
+{
+	static SpriteBatch batch;
+	return batch;
+}
+
+SpriteBatch::SpriteBatch() :
+	m_capacity(0),
+	m_instance_vbo(0),
+	m_projection_uloc(-1),
+	m_sampler_uloc(-1),
+	m_draw_calls(0),
+	m_sprite_count(0),
+	m_culled_count(0)
+{
+}
+
+bool SpriteBatch::init()
+{
+	// Unit quad, scaled per instance by the sprite size
+	vec2 corners[4] = { { -0.5f, +0.5f }, { +0.5f, +0.5f }, { +0.5f, -0.5f }, { -0.5f, -0.5f } };
+
+	// counterclockwise as it's the default opengl front winding direction
+	uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
+
+	// Clearing errors
+	gl_flush_errors();
+
+	glGenVertexArrays(1, &m_quad.vao);
+	glBindVertexArray(m_quad.vao);
+
+	// Vertex Buffer creation
+	glGenBuffers(1, &m_quad.vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, m_quad.vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(CORNER_LOC);
+	glVertexAttribPointer(CORNER_LOC, 2, GL_FLOAT, GL_FALSE, sizeof(vec2), (void*)0);
+
+	// Index Buffer creation, captured by the VAO
+	glGenBuffers(1, &m_quad.ibo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quad.ibo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+	// Instance Buffer creation, refilled on every flush
+	m_capacity = INITIAL_CAPACITY;
+	glGenBuffers(1, &m_instance_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, m_instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Instance) * m_capacity, nullptr, GL_STREAM_DRAW);
+
+	GLuint instance_locs[] = { TRANSFORM_LOC, TRANSFORM_LOC + 1, TRANSFORM_LOC + 2, SIZE_LOC, UV_MIN_LOC, UV_MAX_LOC, TINT_LOC, DEPTH_LOC };
+	for (GLuint loc : instance_locs)
+	{
+		glEnableVertexAttribArray(loc);
+		glVertexAttribDivisor(loc, 1);
+	}
+	bind_instance_attributes(0);
+
+	glBindVertexArray(0);
+	if (gl_has_errors())
+		return false;
+
+	// Loading shaders
+	if (!m_effect.load_from_file(shader_path("sprite_batch.vs.glsl"), shader_path("sprite_batch.fs.glsl")))
+		return false;
+
+	m_projection_uloc = m_effect.locations->projection;
+	m_sampler_uloc = m_effect.locations->get_uniform("sampler0");
+	m_instances.reserve(m_capacity);
+	return true;
+}
+
+void SpriteBatch::destroy()
+{
+	glDeleteBuffers(1, &m_quad.vbo);
+	glDeleteBuffers(1, &m_quad.ibo);
+	glDeleteBuffers(1, &m_instance_vbo);
+	glDeleteVertexArrays(1, &m_quad.vao);
+	m_quad = Mesh();
+	m_instance_vbo = 0;
+	m_capacity = 0;
+	m_instances.clear();
+
+	m_effect.release();
+}
+
+void SpriteBatch::begin(const mat3& projection)
+{
+	m_projection = projection;
+	m_instances.clear();
+	m_draw_calls = 0;
+	m_sprite_count = 0;
+	m_culled_count = 0;
+}
+
+void SpriteBatch::submit(const Texture& texture, const mat3& transform, vec2 size,
+	vec2 uv_min, vec2 uv_max, vec3 tint, float depth)
+{
+	// Bounds of the quad in clip space, sprites entirely outside [-1, 1] never reach the GPU
+	vec3 center = mul_vec(m_projection, transform.c2);
+	vec3 axis_x = mul_vec(m_projection, transform.c0);
+	vec3 axis_y = mul_vec(m_projection, transform.c1);
+	float half_w = 0.5f * (std::fabs(axis_x.x) * size.x + std::fabs(axis_y.x) * size.y);
+	float half_h = 0.5f * (std::fabs(axis_x.y) * size.x + std::fabs(axis_y.y) * size.y);
+	if (std::fabs(center.x) - half_w > 1.f || std::fabs(center.y) - half_h > 1.f)
+	{
+		++m_culled_count;
+		return;
+	}
+
+	Instance instance;
+	instance.transform = transform;
+	instance.size = size;
+	instance.uv_min = uv_min;
+	instance.uv_max = uv_max;
+	instance.tint = tint;
+	instance.depth = depth;
+	instance.texture = texture.id;
+	m_instances.push_back(instance);
+}
+
+void SpriteBatch::flush()
+{
+	if (m_instances.empty())
+		return;
+
+	// Back to front, then grouped by texture so every run is a single draw
+	std::stable_sort(m_instances.begin(), m_instances.end(), [](const Instance& a, const Instance& b) {
+		if (a.depth != b.depth)
+			return a.depth > b.depth;
+		return a.texture < b.texture;
+	});
+
+	// Setting shaders
+	GLState::instance().use_program(m_effect.program);
+
+	// Enabling alpha channel for textures
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
+
+	glUniformMatrix3fv(m_projection_uloc, 1, GL_FALSE, (float*)&m_projection);
+	glUniform1i(m_sampler_uloc, 0);
+
+	GLState::instance().bind_vertex_array(m_quad.vao);
+	glBindBuffer(GL_ARRAY_BUFFER, m_instance_vbo);
+
+	// Orphan the previous storage so the driver does not stall on in-flight draws
+	if (m_instances.size() > m_capacity)
+		m_capacity = std::max(m_instances.size(), m_capacity * 2);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Instance) * m_capacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Instance) * m_instances.size(), m_instances.data());
+
+	size_t first = 0;
+	while (first < m_instances.size())
+	{
+		size_t last = first + 1;
+		while (last < m_instances.size() &&
+			m_instances[last].texture == m_instances[first].texture &&
+			m_instances[last].depth == m_instances[first].depth)
+			++last;
+
+		// No base instance in GL 3.3, move the attribute window to the run instead
+		bind_instance_attributes(first);
+		GLState::instance().bind_texture(0, m_instances[first].texture);
+		glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr, (GLsizei)(last - first));
+
+		++m_draw_calls;
+		first = last;
+	}
+
+	GLState::instance().bind_vertex_array(0);
+	m_sprite_count += (int)m_instances.size();
+	m_instances.clear();
+}
+
+int SpriteBatch::get_draw_calls()const
+{
+	return m_draw_calls;
+}
+
+int SpriteBatch::get_sprite_count()const
+{
+	return m_sprite_count;
+}
+
+int SpriteBatch::get_culled_count()const
+{
+	return m_culled_count;
+}
+
+void SpriteBatch::bind_instance_attributes(size_t first)
+{
+	// Expects m_instance_vbo bound to GL_ARRAY_BUFFER
+	size_t base = first * sizeof(Instance);
+	GLsizei stride = sizeof(Instance);
+	size_t transform = base + offsetof(Instance, transform);
+	glVertexAttribPointer(TRANSFORM_LOC, 3, GL_FLOAT, GL_FALSE, stride, (void*)(transform));
+	glVertexAttribPointer(TRANSFORM_LOC + 1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(transform + sizeof(vec3)));
+	glVertexAttribPointer(TRANSFORM_LOC + 2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(transform + 2 * sizeof(vec3)));
+	glVertexAttribPointer(SIZE_LOC, 2, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(Instance, size)));
+	glVertexAttribPointer(UV_MIN_LOC, 2, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(Instance, uv_min)));
+	glVertexAttribPointer(UV_MAX_LOC, 2, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(Instance, uv_max)));
+	glVertexAttribPointer(TINT_LOC, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(Instance, tint)));
+	glVertexAttribPointer(DEPTH_LOC, 1, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(Instance, depth)));
+}
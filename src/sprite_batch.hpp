@@ -0,0 +1,70 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <vector>
+
+// Collects textured quads and renders every run that shares a texture with a single
+// instanced draw call. Entities submit() from their draw() instead of binding their own
+// buffers, World flushes whenever the next draws have to end up on top of the batch.
+class SpriteBatch
+{
+public:
+	static SpriteBatch& instance();
+
+	// Creates the shared quad, the per-instance buffer and loads the batch shader
+	bool init();
+
+	// Releases all the associated resources
+	void destroy();
+
+	// Starts collecting sprites for a frame rendered with the given projection
+	void begin(const mat3& projection);
+
+	// Queues a quad of the given local size centered on the transform origin.
+	// Sprites are drawn back to front by depth, submission order is kept otherwise.
+	// Quads falling entirely outside the projection are dropped.
+	void submit(const Texture& texture, const mat3& transform, vec2 size,
+		vec2 uv_min, vec2 uv_max, vec3 tint, float depth);
+
+	// Draws everything queued so far, one instanced draw per depth/texture run
+	void flush();
+
+	// Draw calls issued, sprites drawn and sprites culled since the last begin()
+	int get_draw_calls()const;
+	int get_sprite_count()const;
+	int get_culled_count()const;
+
+private:
+	SpriteBatch();
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	// Points the per-instance attributes at the record starting at first
+	void bind_instance_attributes(size_t first);
+
+	// Layout of a record in the instance buffer, texture is only used for grouping
+	struct Instance
+	{
+		mat3 transform;
+		vec2 size;
+		vec2 uv_min;
+		vec2 uv_max;
+		vec3 tint;
+		float depth;
+		GLuint texture;
+	};
+
+	std::vector<Instance> m_instances;
+	size_t m_capacity;
+	Mesh m_quad;
+	GLuint m_instance_vbo;
+	Effect m_effect;
+	GLint m_projection_uloc;
+	GLint m_sampler_uloc;
+	mat3 m_projection;
+	int m_draw_calls;
+	int m_sprite_count;
+	int m_culled_count;
+};
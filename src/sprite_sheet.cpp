@@ -0,0 +1,105 @@
+// Header
+#include "sprite_sheet.hpp"
+
+SpriteFrame::SpriteFrame() :
+    uv_offset({ 0.f, 0.f }),
+    uv_scale({ 1.f, 1.f })
+{
+
+}
+
+SpriteFrame::SpriteFrame(vec2 uv_min, vec2 uv_max) :
+    uv_offset(uv_min),
+    uv_scale({ uv_max.x - uv_min.x, uv_max.y - uv_min.y })
+{
+
+}
+
+void SpriteFrame::set_uniforms(GLint uv_offset_uloc, GLint uv_scale_uloc)const
+{
+    glUniform2f(uv_offset_uloc, uv_offset.x, uv_offset.y);
+    glUniform2f(uv_scale_uloc, uv_scale.x, uv_scale.y);
+}
+
+void SpriteSheet::build_frames(int columns, int rows)
+{
+    float frame_width = (float)subWidth / width;
+    float frame_height = 1.f / rows;
+
+    frames.clear();
+    frames.reserve(columns * rows);
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            vec2 uv_min = { column * frame_width, row * frame_height };
+            vec2 uv_max = { (column + 1) * frame_width, (row + 1) * frame_height };
+            frames.push_back(SpriteFrame(uv_min, uv_max));
+        }
+    }
+}
+
+const SpriteFrame& SpriteSheet::get_frame(int index)const
+{
+    return frames[index];
+}
+
+namespace
+{
+    void fill_sprite_quad(TexturedVertex* vertices, float half_width, float half_height, float depth)
+    {
+        vertices[0].position = { -half_width, +half_height, depth };
+        vertices[0].texcoord = { 0.f, 1.f };
+        vertices[1].position = { +half_width, +half_height, depth };
+        vertices[1].texcoord = { 1.f, 1.f };
+        vertices[2].position = { +half_width, -half_height, depth };
+        vertices[2].texcoord = { 1.f, 0.f };
+        vertices[3].position = { -half_width, -half_height, depth };
+        vertices[3].texcoord = { 0.f, 0.f };
+    }
+}
+
+bool gl_create_sprite_quad(Mesh& mesh, float half_width, float half_height, float depth)
+{
+    TexturedVertex vertices[4];
+    fill_sprite_quad(vertices, half_width, half_height, depth);
+
+    // counterclockwise as it's the default opengl front winding direction
+    uint16_t indices[] = { 0, 3, 1, 1, 3, 2 };
+
+    // Clearing errors
+    gl_flush_errors();
+
+    // Vertex Buffer creation
+    glGenBuffers(1, &mesh.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(TexturedVertex) * 4, vertices, GL_STATIC_DRAW);
+
+    // Index Buffer creation
+    glGenBuffers(1, &mesh.ibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * 6, indices, GL_STATIC_DRAW);
+
+    // Vertex Array (Container for Vertex + Index buffer)
+    glGenVertexArrays(1, &mesh.vao);
+
+    return !gl_has_errors();
+}
+
+bool gl_reuse_sprite_quad(Mesh& mesh, float half_width, float half_height, float depth)
+{
+    if (mesh.vao == 0)
+        return gl_create_sprite_quad(mesh, half_width, half_height, depth);
+
+    TexturedVertex vertices[4];
+    fill_sprite_quad(vertices, half_width, half_height, depth);
+
+    // Clearing errors
+    gl_flush_errors();
+
+    // The indices and the layout captured in the VAO do not change, only the corners might
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+
+    return !gl_has_errors();
+}
@@ -1,9 +1,46 @@
 #pragma once
 
 #include "common.hpp"
+#include "animation.hpp"
+
+// stlib
+#include <vector>
+
+// Window of a sprite sheet holding the frame currently displayed, in texture coordinates.
+// Fed to the uv_offset/uv_scale uniforms of animated.vs.glsl so switching frames never
+// touches the vertex buffer.
+struct SpriteFrame
+{
+    SpriteFrame();
+    SpriteFrame(vec2 uv_min, vec2 uv_max);
+
+    // Uploads the window to the uv_offset/uv_scale uniforms of the currently bound program
+    void set_uniforms(GLint uv_offset_uloc, GLint uv_scale_uloc)const;
+
+    vec2 uv_offset;
+    vec2 uv_scale;
+};
 
 struct SpriteSheet : public Texture {
     int totalTiles;
     int subWidth;
     int subHeight;
-};
\ No newline at end of file
+
+    // Precomputes the UV window of every frame. Columns are subWidth texels wide, rows split
+    // the height evenly and frames are numbered left to right, one row after the other.
+    void build_frames(int columns, int rows = 1);
+
+    const SpriteFrame& get_frame(int index)const;
+
+    // Shared by every entity drawing this sheet, entities only keep the frame they display
+    std::vector<SpriteFrame> frames;
+    AnimationSet animations;
+};
+
+// Creates the VBO/IBO/VAO of a sprite quad centered on the origin with texcoords spanning
+// [0, 1]. Animated sprites call this once in init() and only change their SpriteFrame afterwards.
+bool gl_create_sprite_quad(Mesh& mesh, float half_width, float half_height, float depth);
+
+// Same for pooled entities that run init() again when they are recycled: a quad mesh already
+// owns is refilled in place instead of generating new buffers
+bool gl_reuse_sprite_quad(Mesh& mesh, float half_width, float half_height, float depth);
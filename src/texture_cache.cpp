@@ -0,0 +1,103 @@
+// Header
+#include "texture_cache.hpp"
+#include "headless_gl.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../ext/stb_image/stb_image.h"
+
+TextureCache& TextureCache::instance()
+{
+	static TextureCache cache;
+	return cache;
+}
+
+bool TextureCache::acquire(const char* path, Texture& texture)
+{
+	if (path == nullptr)
+		return false;
+
+	auto it = m_textures.find(path);
+	if (it == m_textures.end())
+	{
+		Entry entry;
+		if (!upload(path, entry))
+			return false;
+		entry.ref_count = 0;
+		it = m_textures.insert(std::make_pair(std::string(path), entry)).first;
+	}
+
+	Entry& entry = it->second;
+	++entry.ref_count;
+	texture.id = entry.id;
+	texture.width = entry.width;
+	texture.height = entry.height;
+	texture.cached = true;
+	return true;
+}
+
+void TextureCache::release(Texture& texture)
+{
+	if (texture.id == 0 || !texture.cached)
+		return;
+
+	// Lookups by id only happen when a handle is repointed, a linear scan is enough
+	for (auto it = m_textures.begin(); it != m_textures.end(); ++it)
+	{
+		Entry& entry = it->second;
+		if (entry.id != texture.id)
+			continue;
+
+		if (--entry.ref_count <= 0)
+		{
+			glDeleteTextures(1, &entry.id);
+			m_textures.erase(it);
+		}
+		break;
+	}
+
+	texture.id = 0;
+	texture.cached = false;
+}
+
+void TextureCache::clear()
+{
+	for (auto& pair : m_textures)
+		glDeleteTextures(1, &pair.second.id);
+	m_textures.clear();
+}
+
+size_t TextureCache::size()const
+{
+	return m_textures.size();
+}
+
+bool TextureCache::upload(const char* path, Entry& out)
+{
+	// Entities size their meshes and hitboxes from the image, only the header is needed for that
+	if (is_headless_gl())
+	{
+		if (!stbi_info(path, &out.width, &out.height, NULL))
+			return false;
+		glGenTextures(1, &out.id);
+		return true;
+	}
+
+	stbi_uc* data = stbi_load(path, &out.width, &out.height, NULL, 4);
+	if (data == NULL)
+		return false;
+
+	gl_flush_errors();
+	glGenTextures(1, &out.id);
+	glBindTexture(GL_TEXTURE_2D, out.id);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, out.width, out.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	stbi_image_free(data);
+
+	if (gl_has_errors())
+	{
+		glDeleteTextures(1, &out.id);
+		return false;
+	}
+	return true;
+}
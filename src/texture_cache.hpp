@@ -0,0 +1,47 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <map>
+#include <string>
+
+// Process-wide cache of GL textures, keyed by the path of the image they were decoded from.
+// A Texture is only a handle into it: the first Texture asking for a path decodes and uploads
+// it, everybody after that shares the same GL texture. Textures are reference counted and
+// deleted once the last handle pointing at them is released.
+class TextureCache
+{
+public:
+	static TextureCache& instance();
+
+	// Points texture at the image stored at path, decoding and uploading it on first use
+	bool acquire(const char* path, Texture& texture);
+
+	// Drops the reference held by texture and clears the handle
+	void release(Texture& texture);
+
+	// Deletes every texture still cached, must run while the GL context is alive
+	void clear();
+
+	// Number of distinct textures currently uploaded
+	size_t size()const;
+
+private:
+	TextureCache() {}
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	struct Entry
+	{
+		GLuint id;
+		int width;
+		int height;
+		int ref_count;
+	};
+
+	// Decodes the image and uploads it, returns false and cleans up on failure
+	static bool upload(const char* path, Entry& out);
+
+	std::map<std::string, Entry> m_textures;
+};
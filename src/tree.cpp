@@ -1,5 +1,6 @@
 // Header
 #include "tree.hpp"
+#include "gl_state.hpp"
 
 // internal
 #include "hero.hpp"
@@ -13,6 +14,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cmath>
 
 Texture Tree::tree_texture;
 
@@ -65,6 +67,7 @@ bool Tree::init(vec2 screen)
 	// Loading shaders
 	if (!effect.load_from_file(shader_path("tree.vs.glsl"), shader_path("tree.fs.glsl")))
 		return false;
+	gl_capture_textured_layout(mesh, effect);
 
 	// Setting initial values, scale is negative to make it face the opposite way
 	// 1.0 would be as big as the original texture
@@ -104,39 +107,27 @@ void Tree::draw(const mat3& projection)
 	transform_end();
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(false);
 
 	// Getting uniform locations for glUniform* calls
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
-	GLint species_uloc = glGetUniformLocation(effect.program, "light_up");
-
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint species_uloc = effect.locations->light_up;
 
 	// Set clock
-	GLuint time_uloc = glGetUniformLocation(effect.program, "time");
+	GLuint time_uloc = effect.locations->time;
 	glUniform1f(time_uloc, (float)(glfwGetTime() * 10.0f));
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effect.program, "in_texcoord");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Enabling and binding texture to slot 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, tree_texture.id);
+	GLState::instance().bind_texture(0, tree_texture.id);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
@@ -149,6 +140,11 @@ void Tree::draw(const mat3& projection)
 
 }
 
+GLuint Tree::get_texture_id()const
+{
+	return tree_texture.id;
+}
+
 
 
 vec2 Tree::get_position()const
@@ -156,6 +152,11 @@ vec2 Tree::get_position()const
 	return m_position;
 }
 
+vec2 Tree::get_bounding_box()const
+{
+	return { std::fabs(m_scale.x) * tree_texture.width, std::fabs(m_scale.y) * tree_texture.height };
+}
+
 
 void Tree::set_position(vec2 position)
 {
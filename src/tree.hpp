@@ -34,9 +34,14 @@ public:
 	// Renders the tree trunk
 	void draw(const mat3& projection)override;
 
+	GLuint get_texture_id()const override;
+
 	// Returns the current salmon position
 	vec2 get_position()const;
 
+	// Returns the size of the drawn sprite
+	vec2 get_bounding_box()const;
+
 	void set_position(vec2 position);
 
 private:
@@ -1,5 +1,6 @@
 // Header
 #include "treetrunk.hpp"
+#include "gl_state.hpp"
 
 // internal
 #include "hero.hpp"
@@ -12,6 +13,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <utility>
+#include <cmath>
 
 bool Treetrunk::init(vec2 screen)
 {
@@ -51,6 +54,14 @@ bool Treetrunk::init(vec2 screen)
 	// Done reading
 	fclose(mesh_file);
 
+	// Collision only needs the outline, the trunk is tested as a convex polygon
+	std::vector<vec2> outline;
+	outline.reserve(vertices.size());
+	for (const Vertex& vertex : vertices)
+		outline.push_back({ vertex.position.x, vertex.position.y });
+	convex_hull(std::move(outline), m_hull);
+	m_collider = Collider::hull(nullptr, 0);
+
 	// Clearing errors
 	gl_flush_errors();
 
@@ -72,6 +83,7 @@ bool Treetrunk::init(vec2 screen)
 	// Loading shaders
 	if (!effect.load_from_file(shader_path("colored.vs.glsl"), shader_path("colored.fs.glsl")))
 		return false;
+	gl_capture_colored_layout(mesh, effect);
 
 	// Setting initial values
 	m_scale.x = -100.f;
@@ -104,43 +116,23 @@ void Treetrunk::update(float ms)
 
 void Treetrunk::draw(const mat3& projection)
 {
-	transform_begin();
-
-	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-	// SALMON TRANSFORMATION CODE HERE
-
-	transform_translate(m_position);
-	transform_rotate(m_rotation);
-	transform_scale(m_scale);
-
-
-	transform_end();
+	// transform is kept up to date by set_position()
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glEnable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(true);
 
 	// Getting uniform locations
-	GLint transform_uloc = glGetUniformLocation(effect.program, "transform");
-	GLint color_uloc = glGetUniformLocation(effect.program, "fcolor");
-	GLint projection_uloc = glGetUniformLocation(effect.program, "projection");
-	GLint light_up_uloc = glGetUniformLocation(effect.program, "light_up");
+	GLint transform_uloc = effect.locations->transform;
+	GLint color_uloc = effect.locations->fcolor;
+	GLint projection_uloc = effect.locations->projection;
+	GLint light_up_uloc = effect.locations->light_up;
 
 	// Setting vertices and indices
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
-
-	// Input data location as in the vertex buffer
-	GLint in_position_loc = glGetAttribLocation(effect.program, "in_position");
-	GLint in_color_loc = glGetAttribLocation(effect.program, "in_color");
-	glEnableVertexAttribArray(in_position_loc);
-	glEnableVertexAttribArray(in_color_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(in_color_loc, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(vec3));
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Setting uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float*)&transform);
@@ -150,7 +142,6 @@ void Treetrunk::draw(const mat3& projection)
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float*)&projection);
 
-
 	// Drawing!
 	glDrawElements(GL_TRIANGLES, (GLsizei)m_num_indices, GL_UNSIGNED_SHORT, nullptr);
 
@@ -167,184 +158,52 @@ vec2 Treetrunk::get_position()const
 void Treetrunk::set_position(vec2 position)
 {
 	m_position = position;
+	cache_collision_geometry();
 }
 
 bool Treetrunk::collide_with(Hero &hero)
 {
-	float dx = m_position.x - hero.get_position().x;
-	float dy = m_position.y - hero.get_position().y;
-	float d_sq = dx * dx + dy * dy;
-	float other_r = std::max(hero.get_bounding_box().x, hero.get_bounding_box().y);
-	float my_r = std::max(m_scale.x, m_scale.y);
-	float r = std::max(other_r, my_r);
-
-	r *= 4.f;
-	float top, bottom, left, right;
-	float scale_back = 1.0f;
-	float content_ratio = 0.95f; // we have extra space at the sides of texture
-	float factor = content_ratio * 0.5; // 0.5 because it's half the length and width from boundary to center
-	top = -1.f * hero.get_bounding_box().y / scale_back * factor;
-	bottom = hero.get_bounding_box().y / scale_back * factor;
-	left = -1.f * hero.get_bounding_box().x / scale_back * factor;
-	right = hero.get_bounding_box().x / scale_back * factor;
-	//points before transform
-	vec3 p_top, p_left, p_right, p_bottom,p_top_left,p_top_right,p_bottom_left,p_bottom_right;
-
-	//could add a list of points to test for our game
-	p_top = mul_vec(hero.transform, { 0,top,1 });
-	p_bottom = mul_vec(hero.transform, { 0,bottom,1 });
-	p_left = mul_vec(hero.transform, { left,0,1 });
-	p_right = mul_vec(hero.transform, { right,0,1 });
-	p_top_left = mul_vec(hero.transform, { left,top,1 });
-	p_top_right = mul_vec(hero.transform, { right,top,1 });
-	p_bottom_left = mul_vec(hero.transform, { left,bottom,1 });
-	p_bottom_right = mul_vec(hero.transform, { right,bottom,1 });
-
-	std::vector<vec3> test_points;
-	test_points.emplace_back(p_top);
-	test_points.emplace_back(p_bottom);
-	test_points.emplace_back(p_left);
-	test_points.emplace_back(p_right);
-	test_points.emplace_back(p_top_left);
-	test_points.emplace_back(p_top_right);
-	test_points.emplace_back(p_bottom_left);
-	test_points.emplace_back(p_bottom_right);
-
-	std::vector<vec3> cur_vertices;
-	transform_current_vertex(cur_vertices);
-	if (d_sq < r * r) {
-		//bool res =  mesh_collision(p_top, cur_vertices) || mesh_collision(p_bottom, cur_vertices)
-		//	|| mesh_collision(p_left, cur_vertices) || mesh_collision(p_right, cur_vertices);
-
-		bool res = false;
-		for (auto &test_point : test_points)
-		{
-			res = res || mesh_collision(test_point, cur_vertices);
-		}
-		return res;
-	}
-
-	return false;
+	return collide_with_box(hero.get_position(), hero.get_bounding_box(), hero.transform);
 }
 
-
 bool Treetrunk::collide_with(Projectile &p)
 {
-	float dx = m_position.x - p.get_position().x;
-	float dy = m_position.y - p.get_position().y;
-	float d_sq = dx * dx + dy * dy;
-	float other_r = std::max(p.get_bounding_box().x, p.get_bounding_box().y);
-	float my_r = std::max(m_scale.x, m_scale.y);
-	float r = std::max(other_r, my_r);
-
-	r *= 4.f;
-	float top, bottom, left, right;
-	float scale_back = abs(p.get_scale().x);
-	float factor = 0.95 * 0.5;
-	top = -1.f * p.get_bounding_box().y / scale_back * factor;
-	bottom = p.get_bounding_box().y / scale_back * factor;
-	left = -1.f * p.get_bounding_box().x / scale_back * factor;
-	right = p.get_bounding_box().x / scale_back * factor;
-	//points before transform
-	vec3 p_top, p_left, p_right, p_bottom,p_top_left, p_top_right, p_bottom_left, p_bottom_right;
-
-	//could add a list of points to test for our game
-	p_top = mul_vec(p.transform, { 0,top,1 });
-	p_bottom = mul_vec(p.transform, { 0,bottom,1 });
-	p_left = mul_vec(p.transform, { left,0,1 });
-	p_right = mul_vec(p.transform, { right,0,1 });
-
-	p_top_left = mul_vec(p.transform, { left,top,1 });
-	p_top_right = mul_vec(p.transform, { right,top,1 });
-	p_bottom_left = mul_vec(p.transform, { left,bottom,1 });
-	p_bottom_right = mul_vec(p.transform, { right,bottom,1 });
-
-	std::vector<vec3> test_points;
-	test_points.emplace_back(p_top);
-	test_points.emplace_back(p_bottom);
-	test_points.emplace_back(p_left);
-	test_points.emplace_back(p_right);
-	test_points.emplace_back(p_top_left);
-	test_points.emplace_back(p_top_right);
-	test_points.emplace_back(p_bottom_left);
-	test_points.emplace_back(p_bottom_right);
-
-	std::vector<vec3> cur_vertices;
-	transform_current_vertex(cur_vertices);
-	if (d_sq < r * r) {
-		bool res = false;
-		for (auto &test_point : test_points)
-		{
-			res = res || mesh_collision(test_point, cur_vertices);
-		}
-		return res;
-	}
-
-	return false;
+	return collide_with_box(p.get_position(), p.get_bounding_box(), p.transform);
 }
 
 bool Treetrunk::collide_with(Enemies &e)
 {
-	float dx = m_position.x - e.get_position().x;
-	float dy = m_position.y - e.get_position().y;
-	float d_sq = dx * dx + dy * dy;
-	float other_r = std::max(e.get_bounding_box().x, e.get_bounding_box().y);
-	float my_r = std::max(m_scale.x, m_scale.y);
-	float r = std::max(other_r, my_r);
-
-	r *= 4.f;
-	float top, bottom, left, right;
-	float scale_back = abs(e.get_scale().x);
-	float factor = 0.95 * 0.5;
-	top = -1.f * e.get_bounding_box().y / scale_back * factor;
-	bottom = e.get_bounding_box().y / scale_back * factor;
-	left = -1.f * e.get_bounding_box().x / scale_back * factor;
-	right = e.get_bounding_box().x / scale_back * factor;
-	//points before transform
-	vec3 p_top, p_left, p_right, p_bottom,p_top_left, p_top_right, p_bottom_left, p_bottom_right;
-
-	//could add a list of points to test for our game
-	p_top = mul_vec(e.transform, { 0,top,1 });
-	p_bottom = mul_vec(e.transform, { 0,bottom,1 });
-	p_left = mul_vec(e.transform, { left,0,1 });
-	p_right = mul_vec(e.transform, { right,0,1 });
-
-	p_top_left = mul_vec(e.transform, { left,top,1 });
-	p_top_right = mul_vec(e.transform, { right,top,1 });
-	p_bottom_left = mul_vec(e.transform, { left,bottom,1 });
-	p_bottom_right = mul_vec(e.transform, { right,bottom,1 });
-
-	vec3 p_top_left_middle = mul_vec(e.transform, {left + (right - left) * 0.25f,top,1});
-	vec3 p_top_right_middle = mul_vec(e.transform, { left + (right - left) * 0.75f,top,1 });
-	vec3 p_bottom_left_middle = mul_vec(e.transform, { left + (right - left) * 0.25f,bottom,1 });
-	vec3 p_bottom_right_middle = mul_vec(e.transform, { left + (right - left) * 0.75f,bottom,1 });
-
-
-	std::vector<vec3> test_points;
-	test_points.emplace_back(p_top);
-	test_points.emplace_back(p_bottom);
-	test_points.emplace_back(p_left);
-	test_points.emplace_back(p_right);
-	test_points.emplace_back(p_top_left);
-	test_points.emplace_back(p_top_right);
-	test_points.emplace_back(p_bottom_left);
-	test_points.emplace_back(p_bottom_right);
-	test_points.emplace_back(p_top_left_middle);
-	test_points.emplace_back(p_top_right_middle);
-	test_points.emplace_back(p_bottom_left_middle);
-	test_points.emplace_back(p_bottom_right_middle);
-
-
-	std::vector<vec3> cur_vertices;
-	transform_current_vertex(cur_vertices);
-	if (d_sq < r * r) {
-		bool res = false;
-		for (auto &test_point : test_points)
-		{
-			res = res || mesh_collision(test_point, cur_vertices);
-		}
-		return res;
+	return collide_with_box(e.get_position(), e.get_bounding_box(), e.transform);
+}
+
+const std::vector<vec2>& Treetrunk::get_hull()const
+{
+	return m_world_hull;
+}
+
+void Treetrunk::cache_collision_geometry()
+{
+	transform_begin();
+	transform_translate(m_position);
+	transform_rotate(m_rotation);
+	transform_scale(m_scale);
+	transform_end();
+
+	m_world_hull.clear();
+	for (const vec2& p : m_hull)
+	{
+		vec3 world = mul_vec(transform, { p.x, p.y, 1.f });
+		m_world_hull.push_back({ world.x, world.y });
 	}
 
-	return false;
-}
\ No newline at end of file
+	// A mirroring scale flips the winding, the collider expects counterclockwise
+	if (det({ transform.c0.x, transform.c0.y }, { transform.c1.x, transform.c1.y }) < 0.f)
+		std::reverse(m_world_hull.begin(), m_world_hull.end());
+	m_collider = Collider::hull(m_world_hull.data(), m_world_hull.size());
+}
+
+bool Treetrunk::collide_with_box(vec2 other_position, vec2 box, const mat3& other_transform)const
+{
+	Collider other = Collider::box(other_position, { box.x * 0.5f, box.y * 0.5f }, { other_transform.c0.x, other_transform.c0.y });
+	return collides(m_collider, other);
+}
@@ -7,6 +7,7 @@
 #include "enemy_02.hpp"
 #include "enemy_03.hpp"
 #include "hero.hpp"
+#include "collider.hpp"
 
 class Enemy_01;
 class Fish;
@@ -44,8 +45,22 @@ public:
 
 	bool collide_with(Enemies &e);
 
+	// Counterclockwise world space outline, valid once the trunk is placed
+	const std::vector<vec2>& get_hull()const;
+
 
 private:
+	// Trunks never move once placed, so their transform and world space hull are
+	// rebuilt only when set_position() is called
+	void cache_collision_geometry();
+
+	// Tests the sprite box of another entity, of size box and turned like other_transform
+	bool collide_with_box(vec2 other_position, vec2 box, const mat3& other_transform)const;
+
+	std::vector<vec2> m_hull; // convex hull of the mesh, in mesh space
+	std::vector<vec2> m_world_hull;
+	Collider m_collider; // references m_world_hull
+
 	double w;
 	double h;
 	float zoom_factor;
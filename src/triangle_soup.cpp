@@ -0,0 +1,161 @@
+// Header
+#include "triangle_soup.hpp"
+
+// stlib
+#include <algorithm>
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRIANGLE_SOUP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+TriangleSoup::TriangleSoup() :
+	m_aabb_min({ 0.f, 0.f }),
+	m_aabb_max({ 0.f, 0.f })
+{
+}
+
+void TriangleSoup::build(const mat3& transform, const std::vector<Vertex>& vertices, const std::vector<uint16_t>& indices)
+{
+	m_edges.clear();
+	m_edges.reserve(indices.size() / 3);
+	m_aabb_min = { FLT_MAX, FLT_MAX };
+	m_aabb_max = { -FLT_MAX, -FLT_MAX };
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		vec2 p[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			const vec3& local = vertices[indices[i + k]].position;
+			vec3 world = mul_vec(transform, { local.x, local.y, 1.f });
+			p[k] = { world.x, world.y };
+		}
+
+		// Counterclockwise so the inside is on the left of every edge
+		vec2 e1 = { p[1].x - p[0].x, p[1].y - p[0].y };
+		vec2 e2 = { p[2].x - p[0].x, p[2].y - p[0].y };
+		float area = det(e1, e2);
+		if (area == 0.f)
+			continue;
+		if (area < 0.f)
+			std::swap(p[1], p[2]);
+
+		Edges edges;
+		for (int k = 0; k < 3; ++k)
+		{
+			vec2 from = p[k];
+			vec2 to = p[(k + 1) % 3];
+			edges.a[k] = from.y - to.y;
+			edges.b[k] = to.x - from.x;
+			edges.c[k] = -(edges.a[k] * from.x + edges.b[k] * from.y);
+
+			m_aabb_min = { std::min(m_aabb_min.x, from.x), std::min(m_aabb_min.y, from.y) };
+			m_aabb_max = { std::max(m_aabb_max.x, from.x), std::max(m_aabb_max.y, from.y) };
+		}
+		m_edges.push_back(edges);
+	}
+}
+
+void TriangleSoup::clear()
+{
+	m_edges.clear();
+}
+
+size_t TriangleSoup::size()const
+{
+	return m_edges.size();
+}
+
+vec2 TriangleSoup::get_aabb_min()const
+{
+	return m_aabb_min;
+}
+
+vec2 TriangleSoup::get_aabb_max()const
+{
+	return m_aabb_max;
+}
+
+bool TriangleSoup::contains(vec2 point)const
+{
+	return contains(&point, 1) != 0;
+}
+
+uint32_t TriangleSoup::contains(const vec2* points, size_t count)const
+{
+	count = std::min(count, (size_t)32);
+	if (m_edges.empty() || count == 0)
+		return 0;
+
+	// Points outside the bounds can't hit, and most queries miss entirely
+	uint32_t candidates = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const vec2& p = points[i];
+		if (p.x >= m_aabb_min.x && p.x <= m_aabb_max.x && p.y >= m_aabb_min.y && p.y <= m_aabb_max.y)
+			candidates |= 1u << i;
+	}
+	if (candidates == 0)
+		return 0;
+
+#if TRIANGLE_SOUP_SSE2
+	uint32_t hits = 0;
+	for (size_t first = 0; first < count; first += 4)
+	{
+		uint32_t lanes = (candidates >> first) & 0xF;
+		if (lanes == 0)
+			continue;
+
+		// Missing lanes repeat the last point, their bits are masked out below
+		size_t last = std::min(first + 4, count) - 1;
+		const vec2& p0 = points[first];
+		const vec2& p1 = points[std::min(first + 1, last)];
+		const vec2& p2 = points[std::min(first + 2, last)];
+		const vec2& p3 = points[last];
+		__m128 px = _mm_set_ps(p3.x, p2.x, p1.x, p0.x);
+		__m128 py = _mm_set_ps(p3.y, p2.y, p1.y, p0.y);
+		__m128 zero = _mm_setzero_ps();
+		int inside = 0;
+
+		for (const Edges& edges : m_edges)
+		{
+			__m128 in = _mm_set1_ps(-1.f);
+			for (int k = 0; k < 3; ++k)
+			{
+				__m128 e = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edges.a[k]), px),
+					_mm_mul_ps(_mm_set1_ps(edges.b[k]), py)), _mm_set1_ps(edges.c[k]));
+				in = _mm_and_ps(in, _mm_cmpge_ps(e, zero));
+			}
+			inside |= _mm_movemask_ps(in);
+			if ((inside & lanes) == lanes)
+				break;
+		}
+		hits |= ((uint32_t)inside & lanes) << first;
+	}
+	return hits;
+#else
+	return contains_scalar(points, count) & candidates;
+#endif
+}
+
+uint32_t TriangleSoup::contains_scalar(const vec2* points, size_t count)const
+{
+	uint32_t hits = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const vec2& p = points[i];
+		for (const Edges& edges : m_edges)
+		{
+			if (edges.a[0] * p.x + edges.b[0] * p.y + edges.c[0] >= 0.f &&
+				edges.a[1] * p.x + edges.b[1] * p.y + edges.c[1] >= 0.f &&
+				edges.a[2] * p.x + edges.b[2] * p.y + edges.c[2] >= 0.f)
+			{
+				hits |= 1u << i;
+				break;
+			}
+		}
+	}
+	return hits;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "common.hpp"
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// World space triangles of a mesh stored as edge equations, for testing many points against
+// the mesh at once. Every triangle keeps the three lines bounding it, oriented so a point is
+// inside when it is on the non-negative side of all three. Points are tested four at a time
+// with SSE2 where the compiler targets it, one at a time otherwise.
+// Rebuilding keeps the storage, so a soup can be refilled every tick without allocating.
+class TriangleSoup
+{
+public:
+	TriangleSoup();
+
+	// Replaces the triangles with the ones of an indexed mesh placed by transform.
+	// Degenerate triangles are dropped, they can't contain anything.
+	void build(const mat3& transform, const std::vector<Vertex>& vertices, const std::vector<uint16_t>& indices);
+
+	void clear();
+
+	// Number of triangles kept
+	size_t size()const;
+
+	// Bit i of the result is set when points[i] lies inside any of the triangles.
+	// At most 32 points per call.
+	uint32_t contains(const vec2* points, size_t count)const;
+
+	bool contains(vec2 point)const;
+
+	// Bounds of every triangle, only valid when the soup is not empty
+	vec2 get_aabb_min()const;
+	vec2 get_aabb_max()const;
+
+private:
+	// e(p) = a * p.x + b * p.y + c for each of the three edges
+	struct Edges
+	{
+		float a[3];
+		float b[3];
+		float c[3];
+	};
+
+	uint32_t contains_scalar(const vec2* points, size_t count)const;
+
+	std::vector<Edges> m_edges;
+	vec2 m_aabb_min;
+	vec2 m_aabb_max;
+};
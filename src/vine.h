@@ -31,6 +31,8 @@ public:
 
 	void draw(const mat3& projection)override;
 
+	GLuint get_texture_id()const override;
+
 	// Returns the current salmon position
 	vec2 get_position()const;
 
@@ -62,13 +64,9 @@ private:
 
 	float variation;
 
-	TexturedVertex texVertices[4];
-
-	std::vector<float> texture_locs;
-
-	float m_animTime = 0.0f;
+	SpriteFrame m_frame; // part of the sprite sheet currently displayed
 
-	int numTiles;
+	AnimationPlayer m_animation;
 
 	bool m_is_alive;
 
@@ -1,4 +1,6 @@
 #include "water.hpp"
+#include "gl_state.hpp"
+#include "game_clock.hpp"
 
 #include <iostream>
 
@@ -25,6 +27,13 @@ bool Water::init() {
 	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(screen_vertex_buffer_data), screen_vertex_buffer_data, GL_STATIC_DRAW);
 
+	// Vertex Array, attribute 0 (in_position) as in the vertex shader
+	glGenVertexArrays(1, &mesh.vao);
+	glBindVertexArray(mesh.vao);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+	glBindVertexArray(0);
+
 	if (gl_has_errors())
 		return false;
 
@@ -32,6 +41,8 @@ bool Water::init() {
 	if (!effect.load_from_file(shader_path("water.vs.glsl"), shader_path("water.fs.glsl")))
 		return false;
 
+	m_screen_texture_uloc = effect.locations->get_uniform("screen_texture");
+	m_dead_timer_uloc = effect.locations->get_uniform("dead_timer");
 	return true;
 }
 
@@ -40,13 +51,11 @@ void Water::destroy() {
     glDeleteBuffers(1, &mesh.ibo);
 	glDeleteVertexArrays(1, &mesh.vao);
 
-    glDeleteShader(effect.vertex);
-    glDeleteShader(effect.fragment);
-    glDeleteShader(effect.program);
+    effect.release();
 }
 
 void Water::set_salmon_dead() {
-	m_dead_time = glfwGetTime();
+	m_dead_time = (float)(GameClock::instance().now() / 1000.0);
 }
 
 void Water::reset_salmon_dead_time() {
@@ -54,35 +63,28 @@ void Water::reset_salmon_dead_time() {
 }
 
 float Water::get_salmon_dead_time() const {
-	return glfwGetTime() - m_dead_time;
+	return (float)(GameClock::instance().now() / 1000.0) - m_dead_time;
 }
 
 void Water::draw(const mat3& projection) {
 	// Enabling alpha channel for textures
-	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glEnable(GL_DEPTH_TEST);
+	GLState::instance().enable_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance().set_depth_test(true);
 
 	// Setting shaders
-	glUseProgram(effect.program);
+	GLState::instance().use_program(effect.program);
 
 	// Set screen_texture sampling to texture unit 0
 	// Set clock
-	GLuint screen_text_uloc = glGetUniformLocation(effect.program, "screen_texture");
-	GLuint time_uloc = glGetUniformLocation(effect.program, "time");
-	GLuint dead_timer_uloc = glGetUniformLocation(effect.program, "dead_timer");
-	glUniform1i(screen_text_uloc, 0);
-	glUniform1f(time_uloc, (float)(glfwGetTime() * 10.0f));
-	glUniform1f(dead_timer_uloc, (m_dead_time > 0) ? (float)((glfwGetTime() - m_dead_time) * 10.0f) : -1);
+	glUniform1i(m_screen_texture_uloc, 0);
+	glUniform1f(effect.locations->time, (float)(glfwGetTime() * 10.0f));
+	glUniform1f(m_dead_timer_uloc, (m_dead_time > 0) ? get_salmon_dead_time() * 10.0f : -1);
 
 	// Draw the screen texture on the quad geometry
 	// Setting vertices
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-
-	// Bind to attribute 0 (in_position) as in the vertex shader
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+	GLState::instance().bind_vertex_array(mesh.vao);
 
 	// Draw
 	glDrawArrays(GL_TRIANGLES, 0, 6); // 2*3 indices starting at 0 -> 2 triangles
-	glDisableVertexAttribArray(0);
+	GLState::instance().bind_vertex_array(0);
 }
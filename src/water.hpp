@@ -23,4 +23,8 @@ public:
 private:
 	// When salmon is alive, the time is set to -1
 	float m_dead_time;
+
+	// Locations of the water specific uniforms
+	GLint m_screen_texture_uloc;
+	GLint m_dead_timer_uloc;
 };
@@ -1,10 +1,23 @@
 // Header
 #include "world.hpp"
+#include "gl_state.hpp"
+#include "render_queue.hpp"
+#include "sprite_batch.hpp"
+#include "texture_cache.hpp"
+#include "font_atlas.hpp"
+#include "compaction.hpp"
+#include "game_clock.hpp"
+#include "headless_gl.hpp"
+#include "game_random.hpp"
+#include "Ice_arrow.h"
 
 // stlib
+#include <algorithm>
+#include <cmath>
 #include <string.h>
 #include <cassert>
 #include <sstream>
+#include <utility>
 #include <gl3w.h>
 
 // Same as static in c, local to compilation unit
@@ -33,9 +46,22 @@ namespace
 			fprintf(stderr, "%d: %s", error, desc);
 		}
 	}
+
+	// Constructs an entity in place at the back of list and initializes it there, entities
+	// are move-only. Drops it again if init() fails.
+	template <typename T, typename... Args>
+	bool emplace_initialized(std::vector<T>& list, Args&&... args)
+	{
+		list.emplace_back();
+		if (list.back().init(std::forward<Args>(args)...))
+			return true;
+		list.pop_back();
+		return false;
+	}
 }
 
 World::World() :
+	m_show_stats(false),
 	m_points(0),
 	previous_point(0),
 	m_next_enemy1_spawn(0.f),
@@ -54,7 +80,168 @@ World::~World()
 }
 
 // World initialization
-bool World::init(vec2 screen)
+bool World::init(vec2 screen, bool headless)
+{
+	m_headless = headless;
+	m_tick = 0;
+	if (headless)
+	{
+		// No window and no audio device, GL goes nowhere and the sounds stay null
+		m_window = nullptr;
+		m_frame_buffer = 0;
+		install_headless_gl();
+	}
+	else if (!init_window(screen) || !init_audio())
+		return false;
+
+	m_current_speed = 1.f;
+	zoom_factor = 1.f;
+	start_is_over = start.is_over();
+	m_level = 0;
+	m_game_level = 0;
+	pass_points = 5;
+	used_skillpoints = 0;
+	skill_num = 0;
+	item_num = 0;
+	page_num = 1;
+	ice_skill_set = { 0.f,0.f,0.f };
+	thunder_skill_set = { 0.f,0.f,0.f };
+	fire_skill_set = { 0.f,0.f,0.f };
+	level_num = { 0.f,0.f,1.f };
+	game_is_paused = false;
+	shopping = false;
+	skill_element = "ice";
+	m_window_width = screen.x;
+	m_window_height = screen.y;
+    // The font is rasterized once, the other texts reuse its atlas
+    map_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
+    skill_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
+    hp_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
+    mp_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
+    exp_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
+	stree.init(screen, 1);
+	m_hero.init(screen);
+	m_portal.init(screen);
+	m_skill_switch.init({ 500.f, 500.f });
+	intro_text.init({ screen.x / 2.f, screen.y }, screen, 0.8f);
+	m_story.init(screen);
+	passed_level = false;
+	shootingFireBall = false;
+	cur_points_needed = pass_points - m_points;
+	kill_num = number_to_vec(cur_points_needed, true);
+	drawIntro = false;
+
+	shop.init();
+	shop.update_hero(m_hero);
+	button_play.makeButton(438, 410, 420, 60, 0.1f, "button_purple.png", "Start", [this]() {
+		drawIntro = true;
+		while (!Mix_FadeOutMusic(500) && Mix_PlayingMusic()) {
+			// wait for any fades to complete
+			SDL_Delay(100);
+		}
+		Mix_PlayMusic(m_intro_music, 1);
+
+	});
+	button_play.set_hoverable(true);
+	button_tutorial.makeButton(438, 510, 420, 60, 0.1f, "button_purple.png", "Start", [&]() {
+		display_tutorial = true;
+		Mix_PlayChannel(-1, m_tutorial_sound, -1);
+	});
+	button_shop.makeButton(438, 610, 420, 60, 0.1f, "button_purple.png", "Start", [&]() {
+		shopping = true;
+		Mix_PlayChannel(-1, m_shop_sound, -1);
+	});
+	button_back_to_menu.makeButton(801, 30, 429, 90, 0.1f, "button_purple.png", "Start", [&]() {
+		display_tutorial = false; page_num = 1;
+		Mix_FadeOutChannel(-1, 500); });
+	button_back_to_menu2.makeButton(985, 25, 260, 50, 0.1f, "button_purple.png", "Start", [&]() {
+		shopping = false;
+		Mix_FadeOutChannel(-1, 500);
+	});
+	button_tutorial_next_page.makeButton(1045, 600, 180, 105, 0.1f, "button_purple.png", "Start", [&]() { page_num =std::min(4, page_num+1); });
+	button_tutorial_prevous_page.makeButton(25, 600, 300, 105, 0.1f, "button_purple.png", "Start", [&]() { page_num = std::max(1, page_num - 1); });
+	button_back_from_skillscreen.makeButton(1150, 30, 90, 90, "button_close.png", "Start", [&]() { 
+		if (game_is_paused) {
+			zoom_factor = 1.1f;
+		}
+		else {
+			zoom_factor = 1.f;
+		}
+		game_is_paused = !game_is_paused;
+	});
+	// For future reference: examples of how to use buttons
+	// testButton2.makeButton(500, 600, 200, 50, 0.8f, "button.png", "Start", [&]() { World::startGame(); });
+	// testButton2.makeButton(500, 600, 300, 50, 0.8f, "BAR.png", "Tutorial", [this]() { this->doNothing(); });
+	// testButton4.makeButton(500, 600, 200, 50, 0.8f, "button.png", "Start", [this]() { this->m_hero.change_mp(80.f); });
+	button_skip_intro.makeButton(1045, 600, 200, 70, 0.1f, "button_purple.png", "Start", [&]() { drawIntro = false; World::startGame(); });
+
+	//initialize treetrunk & tree;
+	m_treetrunk_position.push_back({ 4* screen.x / 5 - 120.f, screen.y / 3  });
+	m_treetrunk_position.push_back({ 4* screen.x / 5 , screen.y / 3 - 50.f });
+	m_treetrunk_position.push_back({ screen.x / 4 , screen.y / 4 });
+	m_treetrunk_position.push_back({ screen.x / 4 - 120.f , screen.y / 4 + 50.f });
+	m_treetrunk_position.push_back({ 2* screen.x  / 3 , screen.y *3/ 4  });
+
+	m_box_position.push_back({ 3 * screen.x / 5 - 200.f, screen.y / 3 });
+	m_box_position.push_back({ 4 * screen.x / 5 , screen.y / 3 - 50.f });
+	m_box_position.push_back({ screen.x / 4 , screen.y / 4 });
+	m_box_position.push_back({ 2 * screen.x / 3 , screen.y * 3 / 4 });
+	m_box_position.push_back({ screen.x / 3 , screen.y * 3 / 4 + 50.f });
+
+	initTrees();
+
+	// Spare cores run the parallel parts of update()
+	JobSystem::instance().init();
+
+	mouse_position = { 0.f,0.f };
+	return SpriteBatch::instance().init() && start.init(screen) && m_water.init() && m_interface.init({ 300.f, 42.f }, m_hero.max_hp) && m_tutorial.init(screen) && shop_screen.init(screen) && hme.init(screen) && ingame.init(screen);
+}
+
+bool World::start_recording(const char* path, float step_ms)
+{
+	std::random_device device;
+	ReplayHeader header;
+	header.rand_seed = device();
+	header.rng_seed = device();
+	header.step_ms = step_ms;
+	get_framebuffer_size(header.screen_width, header.screen_height);
+	header.shop_state = Json::FastWriter().write(shop.shop_info);
+	if (!m_recorder.init(path, header))
+		return false;
+
+	seed_random(header.rand_seed, header.rng_seed);
+	return true;
+}
+
+bool World::start_replay(const char* path, float& step_ms)
+{
+	ReplayHeader header;
+	if (!m_player.init(path, header))
+		return false;
+
+	// Spawn positions and the hero bounds depend on the screen size
+	int w, h;
+	get_framebuffer_size(w, h);
+	if (w != header.screen_width || h != header.screen_height)
+		fprintf(stderr, "Replay was recorded at %dx%d and runs at %dx%d, it will diverge\n",
+			header.screen_width, header.screen_height, w, h);
+
+	// Purchases change the hero, start from the shop the session started with
+	Json::Reader reader;
+	if (!reader.parse(header.shop_state, shop.shop_info, false))
+	{
+		fprintf(stderr, "Failed to read the shop state of replay %s\n", path);
+		m_player.destroy();
+		return false;
+	}
+	shop.update_hero(m_hero);
+
+	seed_random(header.rand_seed, header.rng_seed);
+	step_ms = header.step_ms;
+	return true;
+}
+
+bool World::init_window(vec2 screen)
 {
 	//-------------------------------------------------------------------------
 	// GLFW / OGL Initialization
@@ -91,10 +278,11 @@ bool World::init(vec2 screen)
 	// Input is handled using GLFW, for more info see
 	// http://www.glfw.org/docs/latest/input_guide.html
 	glfwSetWindowUserPointer(m_window, this);
-	auto key_redirect = [](GLFWwindow* wnd, int _0, int _1, int _2, int _3) { ((World*)glfwGetWindowUserPointer(wnd))->on_key(wnd, _0, _1, _2, _3); };
-	auto cursor_pos_redirect = [](GLFWwindow* wnd, double _0, double _1) { ((World*)glfwGetWindowUserPointer(wnd))->on_mouse_move(wnd, _0, _1); };
-	auto mouse_button_callback = [](GLFWwindow* wnd, int _0, int _1, int _2) {((World*)glfwGetWindowUserPointer(wnd))->on_mouse_click(wnd, _0, _1, _2); };
-	auto mouse_wheel_callback = [](GLFWwindow* wnd, double _0, double _1) {((World*)glfwGetWindowUserPointer(wnd))->on_mouse_wheel(wnd, _0, _1); };
+	// Every event goes through on_live_input() so sessions can be recorded and replayed
+	auto key_redirect = [](GLFWwindow* wnd, int _0, int _1, int _2, int _3) { ((World*)glfwGetWindowUserPointer(wnd))->on_live_input({ 0, InputEvent::KEY, _0, _1, _2, _3, 0.0, 0.0 }); };
+	auto cursor_pos_redirect = [](GLFWwindow* wnd, double _0, double _1) { ((World*)glfwGetWindowUserPointer(wnd))->on_live_input({ 0, InputEvent::MOUSE_MOVE, 0, 0, 0, 0, _0, _1 }); };
+	auto mouse_button_callback = [](GLFWwindow* wnd, int _0, int _1, int _2) {((World*)glfwGetWindowUserPointer(wnd))->on_live_input({ 0, InputEvent::MOUSE_BUTTON, _0, 0, _1, _2, 0.0, 0.0 }); };
+	auto mouse_wheel_callback = [](GLFWwindow* wnd, double _0, double _1) {((World*)glfwGetWindowUserPointer(wnd))->on_live_input({ 0, InputEvent::MOUSE_WHEEL, 0, 0, 0, 0, _0, _1 }); };
 
 	glfwSetKeyCallback(m_window, key_redirect);
 	glfwSetCursorPosCallback(m_window, cursor_pos_redirect);
@@ -108,7 +296,11 @@ bool World::init(vec2 screen)
 
 	// Initialize the screen texture
 	m_screen_tex.create_from_screen(m_window);
+	return true;
+}
 
+bool World::init_audio()
+{
 	//-------------------------------------------------------------------------
 	// Loading music and sounds
 	if (SDL_Init(SDL_INIT_AUDIO) < 0)
@@ -176,104 +368,7 @@ bool World::init(vec2 screen)
 	Mix_PlayMusic(m_homescreen_music, -1);
 
 	fprintf(stderr, "Loaded music\n");
-
-	m_current_speed = 1.f;
-	zoom_factor = 1.f;
-	start_is_over = start.is_over();
-	m_level = 0;
-	m_game_level = 0;
-	pass_points = 5;
-	used_skillpoints = 0;
-	skill_num = 0;
-	item_num = 0;
-	page_num = 1;
-	ice_skill_set = { 0.f,0.f,0.f };
-	thunder_skill_set = { 0.f,0.f,0.f };
-	fire_skill_set = { 0.f,0.f,0.f };
-	level_num = { 0.f,0.f,1.f };
-	game_is_paused = false;
-	shopping = false;
-	skill_element = "ice";
-	m_window_width = screen.x;
-	m_window_height = screen.y;
-    map_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
-    skill_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
-    hp_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
-    mp_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
-    exp_text.loadCharacters(font_path("ARCADECLASSIC.TTF"));
-	stree.init(screen, 1);
-	m_hero.init(screen);
-	m_portal.init(screen);
-	m_skill_switch.init({ 500.f, 500.f });
-	intro_text.init({ screen.x / 2.f, screen.y }, screen, 0.8f);
-	m_story.init(screen);
-	passed_level = false;
-	shootingFireBall = false;
-	cur_points_needed = pass_points - m_points;
-	kill_num = number_to_vec(cur_points_needed, true);
-	drawIntro = false;
-
-	shop.init();
-	shop.update_hero(m_hero);
-	button_play.makeButton(438, 410, 420, 60, 0.1f, "button_purple.png", "Start", [this]() {
-		drawIntro = true;
-		while (!Mix_FadeOutMusic(500) && Mix_PlayingMusic()) {
-			// wait for any fades to complete
-			SDL_Delay(100);
-		}
-		Mix_PlayMusic(m_intro_music, 1);
-
-	});
-	button_play.set_hoverable(true);
-	button_tutorial.makeButton(438, 510, 420, 60, 0.1f, "button_purple.png", "Start", [&]() {
-		display_tutorial = true;
-		Mix_PlayChannel(-1, m_tutorial_sound, -1);
-	});
-	button_shop.makeButton(438, 610, 420, 60, 0.1f, "button_purple.png", "Start", [&]() {
-		shopping = true;
-		Mix_PlayChannel(-1, m_shop_sound, -1);
-	});
-	button_back_to_menu.makeButton(801, 30, 429, 90, 0.1f, "button_purple.png", "Start", [&]() {
-		display_tutorial = false; page_num = 1;
-		Mix_FadeOutChannel(-1, 500); });
-	button_back_to_menu2.makeButton(985, 25, 260, 50, 0.1f, "button_purple.png", "Start", [&]() {
-		shopping = false;
-		Mix_FadeOutChannel(-1, 500);
-	});
-	button_tutorial_next_page.makeButton(1045, 600, 180, 105, 0.1f, "button_purple.png", "Start", [&]() { page_num =std::min(4, page_num+1); });
-	button_tutorial_prevous_page.makeButton(25, 600, 300, 105, 0.1f, "button_purple.png", "Start", [&]() { page_num = std::max(1, page_num - 1); });
-	button_back_from_skillscreen.makeButton(1150, 30, 90, 90, "button_close.png", "Start", [&]() { 
-		if (game_is_paused) {
-			zoom_factor = 1.1f;
-		}
-		else {
-			zoom_factor = 1.f;
-		}
-		game_is_paused = !game_is_paused;
-	});
-	// For future reference: examples of how to use buttons
-	// testButton2.makeButton(500, 600, 200, 50, 0.8f, "button.png", "Start", [&]() { World::startGame(); });
-	// testButton2.makeButton(500, 600, 300, 50, 0.8f, "BAR.png", "Tutorial", [this]() { this->doNothing(); });
-	// testButton4.makeButton(500, 600, 200, 50, 0.8f, "button.png", "Start", [this]() { this->m_hero.change_mp(80.f); });
-	button_skip_intro.makeButton(1045, 600, 200, 70, 0.1f, "button_purple.png", "Start", [&]() { drawIntro = false; World::startGame(); });
-
-	//initialize treetrunk & tree;
-	m_treetrunk_position.push_back({ 4* screen.x / 5 - 120.f, screen.y / 3  });
-	m_treetrunk_position.push_back({ 4* screen.x / 5 , screen.y / 3 - 50.f });
-	m_treetrunk_position.push_back({ screen.x / 4 , screen.y / 4 });
-	m_treetrunk_position.push_back({ screen.x / 4 - 120.f , screen.y / 4 + 50.f });
-	m_treetrunk_position.push_back({ 2* screen.x  / 3 , screen.y *3/ 4  });
-
-	m_box_position.push_back({ 3 * screen.x / 5 - 200.f, screen.y / 3 });
-	m_box_position.push_back({ 4 * screen.x / 5 , screen.y / 3 - 50.f });
-	m_box_position.push_back({ screen.x / 4 , screen.y / 4 });
-	m_box_position.push_back({ 2 * screen.x / 3 , screen.y * 3 / 4 });
-	m_box_position.push_back({ screen.x / 3 , screen.y * 3 / 4 + 50.f });
-
-	initTrees();
-
-	mouse_position = { 0.f,0.f };
-	return start.init(screen) && m_water.init() && m_interface.init({ 300.f, 42.f }, m_hero.max_hp) && m_tutorial.init(screen) && shop_screen.init(screen) && hme.init(screen) && ingame.init(screen);
+	return true;
 }
 
 bool World::initTrees() {
@@ -318,11 +413,41 @@ bool World::initTrees() {
 		}
 	}
 
+	build_obstacle_field();
+	return true;
+}
+
+void World::build_obstacle_field()
+{
+	// How far enemies are pushed per ms when touching each kind of obstacle
+	const float PORTAL_PUSH = 0.2f;
+	const float BOX_PUSH = 0.2f;
+	const float TRUNK_PUSH = 0.05f;
+
+	m_obstacle_field.clear();
+
+	vec2 portal_box = m_portal.get_bounding_box();
+	m_obstacle_field.add_circle(m_portal.get_position(), std::max(portal_box.x, portal_box.y), PORTAL_PUSH);
+	for (auto& box : m_box)
+	{
+		vec2 bounding_box = box.get_bounding_box();
+		m_obstacle_field.add_circle(box.get_position(), std::max(bounding_box.x, bounding_box.y), BOX_PUSH);
+	}
+	for (auto& treetrunk : m_treetrunk)
+		m_obstacle_field.add_hull(treetrunk.get_hull(), TRUNK_PUSH);
+
+	// Wide enough for the largest enemy to be detected before its center reaches an obstacle
+	m_obstacle_field.build(128.f);
+
+	// Paths keep enemy centers this far from the obstacles
+	m_flow_field.build({ 0.f, 0.f }, { m_window_width, m_window_height }, m_obstacle_field, 24.f);
 }
 
 // Releases all the associated resources
 void World::destroy()
 {
+	m_recorder.destroy(m_tick);
+	m_player.destroy();
 	glDeleteFramebuffers(1, &m_frame_buffer);
 
 	if (m_background_music != nullptr)
@@ -382,12 +507,14 @@ void World::destroy()
 	for (auto& thunder : thunders)
 		thunder->destroy();
 	for (auto& phoenix : phoenix_list)
-		phoenix->destroy(true);
+		phoenix->destroy();
 
 	m_enemys_01.clear();
 	m_enemys_02.clear();
 	hero_projectiles.clear();
 	enemy_projectiles.clear();
+	thunders.clear();
+	phoenix_list.clear();
 	m_interface.destroy();
 	ingame.destroy();
 	m_skill_switch.destroy(true);
@@ -396,6 +523,11 @@ void World::destroy()
 	hme.destroy();
 	intro_text.destroy();
 	m_story.destroy();
+	map_text.release();
+	skill_text.release();
+	hp_text.release();
+	mp_text.release();
+	exp_text.release();
 	button_play.destroy();
 	button_tutorial.destroy();
 	button_tutorial_next_page.destroy();
@@ -405,14 +537,40 @@ void World::destroy()
 	button_skip_intro.destroy();
 	button_back_to_menu2.destroy();
 	button_back_from_skillscreen.destroy();
-	glfwDestroyWindow(m_window);
+	SpriteBatch::instance().destroy();
+	JobSystem::instance().destroy();
+	// Pools outlive the window as well, the entities handed back above still own GL objects
+	Fireball::pool().clear();
+	Ice_arrow::pool().clear();
+	Thunder::pool().clear();
+	phoenix::pool().clear();
+	// Static textures and fonts outlive the window, their GL objects have to go while the context is alive
+	TextureCache::instance().clear();
+	FontCache::instance().clear();
+	if (m_window != nullptr)
+		glfwDestroyWindow(m_window);
 }
 
 // Update our game world
 bool World::update(float elapsed_ms)
 {
+	// Replayed input arrives where it was recorded, ahead of the step it preceded
+	InputEvent event;
+	while (m_player.next(m_tick, event))
+		dispatch_input(event);
+	++m_tick;
+
+	save_previous_positions();
+
+	// Gameplay timers only run while the game itself does, at the chosen game speed
+	GameClock& game_clock = GameClock::instance();
+	game_clock.set_paused(game_is_paused || shopping);
+	game_clock.set_time_scale(m_current_speed);
+	game_clock.tick(elapsed_ms);
+	m_hero.update_transition();
+
 	int w, h;
-	glfwGetFramebufferSize(m_window, &w, &h);
+	get_framebuffer_size(w, h);
 	vec2 screen = { (float)w, (float)h };
 
 	start.update(start_is_over);
@@ -480,10 +638,10 @@ bool World::update(float elapsed_ms)
 	if (start_is_over && !game_is_paused && !shopping && !m_hero.isInTransition) {
 
 		if (m_hero.is_alive()) {
-			if (shootingFireBall && clock() - lastFireProjectileTime > 300) {
-				m_hero.shoot_projectiles(hero_projectiles);
+			// A full pool shoots nothing, the next step tries again
+			if (shootingFireBall && game_clock.since(lastFireProjectileTime) > 300 && m_hero.shoot_projectiles(hero_projectiles)) {
 				Mix_PlayChannel(-1, m_fireball_sound, 0);
-				lastFireProjectileTime = clock();
+				lastFireProjectileTime = game_clock.now();
 			}
 
 			// Checking hero - Enemy collisions
@@ -519,15 +677,12 @@ bool World::update(float elapsed_ms)
 			}
 
 			// Checking hero - Enemy collisions
-			auto e_proj = enemy_projectiles.begin();
-			while (e_proj != enemy_projectiles.end())
+			for (auto& e_proj : enemy_projectiles)
 			{
-				if (m_hero.collides_with(*e_proj))
+				if (m_hero.collides_with(e_proj))
 				{
-					m_hero.take_damage(e_proj->get_damage());
-					//comment back later
-					e_proj->destroy();
-					e_proj = enemy_projectiles.erase(e_proj);
+					m_hero.take_damage(e_proj.get_damage());
+					e_proj.mark_removed();
 					if (!m_hero.is_alive()) {
 						Mix_PlayChannel(-1, m_salmon_dead_sound, 0);
 						m_water.set_salmon_dead();
@@ -535,7 +690,6 @@ bool World::update(float elapsed_ms)
 					}
 					break;
 				}
-				++e_proj;
 			}
 
 			if (m_hero.get_position().y > m_window_height - m_hero.m_scale.y * 2) {
@@ -571,7 +725,7 @@ bool World::update(float elapsed_ms)
 			}
 		}
 
-		for (Enemy_01 enemy : m_enemys_01)
+		for (auto& enemy : m_enemys_01)
 		{
 			if (enemy.needFireProjectile == true)
 			{
@@ -586,9 +740,9 @@ bool World::update(float elapsed_ms)
 			{
 				enemy.set_wave();
 				Mix_PlayChannel(-1, m_amplify_sound, 0);
-				int rand_factor = 0 + (std::rand() % (1 - 0 + 1));
+				int rand_factor = 0 + (game_rand() % (1 - 0 + 1));
 				int group_behavior_chance = std::min(50, std::max(0 , (int) m_points / 2));
-				if (rand() % 100 < group_behavior_chance) {
+				if (game_rand() % 100 < group_behavior_chance) {
 					if (rand_factor == 0)
 					{
 						enemy.recentPowerupType = 4;
@@ -627,7 +781,7 @@ bool World::update(float elapsed_ms)
 								m_enemys_01[0].set_wave();
 							}
 							else {
-								rand_factor = std::rand() % factor + 0;
+								rand_factor = game_rand() % factor + 0;
 								enemy.recentPowerupType = m_enemys_01[rand_factor].powerup();
 								m_enemys_01[rand_factor].set_wave();
 							}
@@ -641,7 +795,7 @@ bool World::update(float elapsed_ms)
 								m_enemys_02[0].set_wave();
 							}
 							else {
-								rand_factor = std::rand() % factor + 0;
+								rand_factor = game_rand() % factor + 0;
 								enemy.recentPowerupType = m_enemys_02[rand_factor].powerup();
 								m_enemys_02[rand_factor].set_wave();
 							}
@@ -655,20 +809,42 @@ bool World::update(float elapsed_ms)
 		// faster based on current
 
 		m_hero.update(elapsed_ms);
-		for (auto& enemy : m_enemys_01)
-			enemy.update(elapsed_ms * m_current_speed, m_hero.get_position());
-		for (auto& enemy : m_enemys_02)
-			enemy.update(elapsed_ms * m_current_speed, m_hero.get_position());
-		for (auto& enemy : m_enemys_03)
-			enemy.update(elapsed_ms * m_current_speed, m_hero.get_position());
-		for (auto& h_proj : hero_projectiles)
-			h_proj->update(elapsed_ms * m_current_speed);
-		for (auto& e_proj : enemy_projectiles)
-			e_proj.update(elapsed_ms * m_current_speed);
-		for (auto& vine : m_vine)
-			vine.update(elapsed_ms * m_current_speed);
-		for (auto& box : m_box)
-			box.update(elapsed_ms * m_current_speed);
+
+		// Only searches again when the hero entered another cell
+		m_flow_field.update(m_hero.get_position());
+
+		// Entity lists only touching their own entities update side by side on the workers.
+		// Enemies stay on this thread: their AI draws from game_rand(), which is shared by the
+		// whole game, so the sequence must not depend on which thread picks the task up.
+		float entity_ms = elapsed_ms * m_current_speed;
+		vec2 hero_position = m_hero.get_position();
+		JobSystem& jobs = JobSystem::instance();
+		m_update_graph.clear();
+		m_update_graph.add([this, &jobs, entity_ms]() {
+			jobs.parallel_for(hero_projectiles.size(), 64, [this, entity_ms](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					hero_projectiles[i]->update(entity_ms);
+			});
+		});
+		m_update_graph.add([this, &jobs, entity_ms]() {
+			jobs.parallel_for(enemy_projectiles.size(), 64, [this, entity_ms](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					enemy_projectiles[i].update(entity_ms);
+			});
+		});
+		m_update_graph.add([this, entity_ms]() {
+			for (auto& vine : m_vine)
+				vine.update(entity_ms);
+			for (auto& box : m_box)
+				box.update(entity_ms);
+		});
+		std::atomic<int> others_pending(1);
+		jobs.submit([this]() { m_update_graph.run(); }, others_pending);
+		for_each_enemy([this, entity_ms, hero_position](Enemies& enemy) {
+			enemy.set_path_direction(m_flow_field.direction(enemy.get_position()));
+			enemy.update(entity_ms, hero_position);
+		});
+		jobs.wait(others_pending);
 		m_portal.update(elapsed_ms * m_current_speed, cur_points_needed - (pass_points - m_points), cur_points_needed);
 		m_interface.update({ m_hero.get_hp(), m_hero.get_mp() }, { (float) (m_points - previous_point), (float) (20 + (m_hero.level * 5)) }, zoom_factor, m_hero.max_hp);
 		for (auto& thunder : thunders)
@@ -680,78 +856,13 @@ bool World::update(float elapsed_ms)
 		kill_num = number_to_vec(pass_points - m_points, true);
 		ingame.update_ingame(start_is_over, level_num, kill_num, screen, m_hero.get_position(), zoom_factor);
 		m_skill_switch.update(m_hero.get_active_skill(), zoom_factor);
-		//check portal collision
-		for (auto &e1 : m_enemys_01)
-		{
-			if (m_portal.collides_with(e1))
-			{
-				vec2 cur_position = e1.get_position();
-				vec2 tree_location = m_portal.get_position();
-				vec2 difference = { cur_position.x - tree_location.x, cur_position.y - tree_location.y };
-				float size = sqrtf(dot(difference, difference));
-				vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-				float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-				float det = difference.x * diffHero.y - difference.y * diffHero.x;
-				float angle = atan2(det, dot);
-				vec2 directDiff = { difference.x / size, difference.y / size };
-				if (angle < 0.f) {
-					difference = { - difference.y / size, difference.x / size };
-				} else {
-					difference = { difference.y / size, - difference.x / size };
-				}
-				float stepback = elapsed_ms * 0.2f;
-				vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-				e1.set_position(new_position);
-			}
-		}
+		// Enemy positions, radii and kinds packed for the collision systems below
+		m_enemy_store.gather(m_enemys_01, m_enemys_02, m_enemys_03);
 
-		for (auto &e2 : m_enemys_02)
-		{
-			if (m_portal.collides_with(e2))
-			{
-				vec2 cur_position = e2.get_position();
-				vec2 tree_location = m_portal.get_position();
-				vec2 difference = { cur_position.x - tree_location.x, cur_position.y - tree_location.y };
-				float size = sqrtf(dot(difference, difference));
-				vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-				float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-				float det = difference.x * diffHero.y - difference.y * diffHero.x;
-				float angle = atan2(det, dot);
-				vec2 directDiff = { difference.x / size, difference.y / size };
-				if (angle < 0.f) {
-					difference = { - difference.y / size, difference.x / size };
-				} else {
-					difference = { difference.y / size, - difference.x / size };
-				}
-				float stepback = elapsed_ms * 0.2f;
-				vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-				e2.set_position(new_position);
-			}
-		}
+		// Enemies slide around the portal, boxes and trunks
+		steer_enemies_around_obstacles(elapsed_ms);
 
-		for (auto &e3 : m_enemys_03)
-		{
-			if (m_portal.collides_with(e3))
-			{
-				vec2 cur_position = e3.get_position();
-				vec2 tree_location = m_portal.get_position();
-				vec2 difference = { cur_position.x - tree_location.x, cur_position.y - tree_location.y };
-				float size = sqrtf(dot(difference, difference));
-				vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-				float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-				float det = difference.x * diffHero.y - difference.y * diffHero.x;
-				float angle = atan2(det, dot);
-				vec2 directDiff = { difference.x / size, difference.y / size };
-				if (angle < 0.f) {
-					difference = { - difference.y / size, difference.x / size };
-				} else {
-					difference = { difference.y / size, - difference.x / size };
-				}
-				float stepback = elapsed_ms * 0.2f;
-				vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-				e3.set_position(new_position);
-			}
-		}
+		//check portal collision
 
 		if (m_portal.collides_with(m_hero)) {
 			vec2 cur_direction = m_hero.get_direction();
@@ -768,107 +879,21 @@ bool World::update(float elapsed_ms)
 			}
 		}
 
-		int p_len = (int)hero_projectiles.size() - 1;
-		for (int i = p_len; i >= 0; i--)
+		for (auto h_proj : hero_projectiles)
 		{
-			Projectile* h_proj = hero_projectiles.at(i);
-			if (m_portal.collides_with(*h_proj))
-			{
-				h_proj->destroy();
-				hero_projectiles.erase(hero_projectiles.begin() + i);
-			}
+			if (!h_proj->is_removed() && m_portal.collides_with(*h_proj))
+				h_proj->mark_removed();
 		}
 
 		//same for enemy projectile
-		int l_len = (int)enemy_projectiles.size() - 1;
-		for (int i = l_len; i >= 0; i--)
+		for (auto& laser : enemy_projectiles)
 		{
-			EnemyLaser laser = enemy_projectiles.at(i);
-			if (m_portal.collides_with(laser))
-			{
-				laser.destroy();
-				enemy_projectiles.erase(enemy_projectiles.begin() + i);
-			}
+			if (!laser.is_removed() && m_portal.collides_with(laser))
+				laser.mark_removed();
 		}
 		//check box collision
 		for (auto &box : m_box) {
 
-			for (auto &e1 : m_enemys_01)
-			{
-
-				if (box.collides_with(e1))
-				{
-					vec2 cur_position = e1.get_position();
-					vec2 box_location = box.get_position();
-					vec2 difference = { cur_position.x - box_location.x, cur_position.y - box_location.y };
-					float size = sqrtf(dot(difference, difference));
-					vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-					float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-					float det = difference.x * diffHero.y - difference.y * diffHero.x;
-					float angle = atan2(det, dot);
-					vec2 directDiff = { difference.x / size, difference.y / size };
-					if (angle < 0.f) {
-						difference = { -difference.y / size, difference.x / size };
-					}
-					else {
-						difference = { difference.y / size, -difference.x / size };
-					}
-					float stepback = elapsed_ms * 0.2f;
-					vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-					e1.set_position(new_position);
-				}
-			}
-
-			for (auto &e2 : m_enemys_02)
-			{
-				if (box.collides_with(e2))
-				{
-					vec2 cur_position = e2.get_position();
-					vec2 box_location = box.get_position();
-					vec2 difference = { cur_position.x - box_location.x, cur_position.y - box_location.y };
-					float size = sqrtf(dot(difference, difference));
-					vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-					float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-					float det = difference.x * diffHero.y - difference.y * diffHero.x;
-					float angle = atan2(det, dot);
-					vec2 directDiff = { difference.x / size, difference.y / size };
-					if (angle < 0.f) {
-						difference = { -difference.y / size, difference.x / size };
-					}
-					else {
-						difference = { difference.y / size, -difference.x / size };
-					}
-					float stepback = elapsed_ms * 0.2f;
-					vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-					e2.set_position(new_position);
-				}
-			}
-
-			for (auto &e3 : m_enemys_03)
-			{
-				if (box.collides_with(e3))
-				{
-					vec2 cur_position = e3.get_position();
-					vec2 box_location = box.get_position();
-					vec2 difference = { cur_position.x - box_location.x, cur_position.y - box_location.y };
-					float size = sqrtf(dot(difference, difference));
-					vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-					float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-					float det = difference.x * diffHero.y - difference.y * diffHero.x;
-					float angle = atan2(det, dot);
-					vec2 directDiff = { difference.x / size, difference.y / size };
-					if (angle < 0.f) {
-						difference = { -difference.y / size, difference.x / size };
-					}
-					else {
-						difference = { difference.y / size, -difference.x / size };
-					}
-					float stepback = elapsed_ms * 0.2f;
-					vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-					e3.set_position(new_position);
-				}
-			}
-
 			if (box.collides_with(m_hero)) {
 				vec2 cur_direction = m_hero.get_direction();
 				vec2 cur_position = m_hero.get_position();
@@ -877,27 +902,17 @@ bool World::update(float elapsed_ms)
 				m_hero.set_position(new_position);
 			}
 
-			p_len = (int)hero_projectiles.size() - 1;
-			for (int i = p_len; i >= 0; i--)
+			for (auto h_proj : hero_projectiles)
 			{
-				Projectile* h_proj = hero_projectiles.at(i);
-				if (box.collides_with(*h_proj))
-				{
-					h_proj->destroy();
-					hero_projectiles.erase(hero_projectiles.begin() + i);
-				}
+				if (!h_proj->is_removed() && box.collides_with(*h_proj))
+					h_proj->mark_removed();
 			}
 
 			//same for enemy projectile
-			l_len = (int)enemy_projectiles.size() - 1;
-			for (int i = l_len; i >= 0; i--)
+			for (auto& laser : enemy_projectiles)
 			{
-				EnemyLaser laser = enemy_projectiles.at(i);
-				if (box.collides_with(laser))
-				{
-					laser.destroy();
-					enemy_projectiles.erase(enemy_projectiles.begin() + i);
-				}
+				if (!laser.is_removed() && box.collides_with(laser))
+					laser.mark_removed();
 			}
 
 
@@ -926,474 +941,162 @@ bool World::update(float elapsed_ms)
 				float stepback = elapsed_ms * 0.6; // -0.2 is 200 / 1000, which is in hero.cpp so 0.4 to stepback more so the hero does not stuck on it
 				vec2 new_position = { cur_position.x + difference.x * stepback, cur_position.y + difference.y * stepback  };
 
-				m_hero.set_position(new_position);
-			}
-
-			// if hero projectile hit the tree trunck then destroy it
-			int p_len = (int)hero_projectiles.size() - 1;
-			for (int i = p_len; i >= 0; i--)
-			{
-				Projectile* h_proj = hero_projectiles.at(i);
-				if (treeTrunk.collide_with(*h_proj))
-				{
-					h_proj->destroy();
-					hero_projectiles.erase(hero_projectiles.begin() + i);
-				}
-			}
-
-			//same for enemy projectile
-			l_len = (int)enemy_projectiles.size() - 1;
-			for (int i = l_len; i >= 0; i--)
-			{
-				EnemyLaser laser = enemy_projectiles.at(i);
-				if (treeTrunk.collide_with(laser))
-				{
-					laser.destroy();
-					enemy_projectiles.erase(enemy_projectiles.begin() + i);
-				}
-			}
-
-			for (auto &e1 : m_enemys_01)
-			{
-				if (treeTrunk.collide_with(e1))
-				{
-					vec2 cur_position = e1.get_position();
-					vec2 tree_location = treeTrunk.get_position();
-					vec2 difference = { cur_position.x - tree_location.x, cur_position.y - tree_location.y };
-					float size = sqrtf(dot(difference, difference));
-					vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-					float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-					float det = difference.x * diffHero.y - difference.y * diffHero.x;
-					float angle = atan2(det, dot);
-					vec2 directDiff = { difference.x / size, difference.y / size };
-					if (angle < 0.f) {
-						difference = { - difference.y / size, difference.x / size };
-					} else {
-						difference = { difference.y / size, - difference.x / size };
-					}
-					float stepback = elapsed_ms * 0.05f;
-					vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-					e1.set_position(new_position);
-				}
-			}
-
-			for (auto &e2 : m_enemys_02)
-			{
-				if (treeTrunk.collide_with(e2))
-				{
-					vec2 cur_position = e2.get_position();
-					vec2 tree_location = treeTrunk.get_position();
-					vec2 difference = { cur_position.x - tree_location.x, cur_position.y - tree_location.y };
-					float size = sqrtf(dot(difference, difference));
-					vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-					float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-					float det = difference.x * diffHero.y - difference.y * diffHero.x;
-					float angle = atan2(det, dot);
-					vec2 directDiff = { difference.x / size, difference.y / size };
-					if (angle < 0.f) {
-						difference = { - difference.y / size, difference.x / size };
-					} else {
-						difference = { difference.y / size, - difference.x / size };
-					}
-					float stepback = elapsed_ms * 0.05f;
-					vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-					e2.set_position(new_position);
-				}
-			}
-
-			for (auto &e3 : m_enemys_03)
-			{
-				if (treeTrunk.collide_with(e3))
-				{
-					vec2 cur_position = e3.get_position();
-					vec2 tree_location = treeTrunk.get_position();
-					vec2 difference = { cur_position.x - tree_location.x, cur_position.y - tree_location.y };
-					float size = sqrtf(dot(difference, difference));
-					vec2 diffHero = { cur_position.x - m_hero.get_position().x, cur_position.y - m_hero.get_position().y };
-					float dot = difference.x * diffHero.x + difference.y * diffHero.y;
-					float det = difference.x * diffHero.y - difference.y * diffHero.x;
-					float angle = atan2(det, dot);
-					vec2 directDiff = { difference.x / size, difference.y / size };
-					if (angle < 0.f) {
-						difference = { - difference.y / size, difference.x / size };
-					} else {
-						difference = { difference.y / size, - difference.x / size };
-					}
-					float stepback = elapsed_ms * 0.05f;
-					vec2 new_position = { cur_position.x + (difference.x + directDiff.x)* stepback, cur_position.y + (difference.y + directDiff.y) * stepback };
-					e3.set_position(new_position);
-				}
-			}
-		}
-
-		//check collision between phoenix and enemies
-
-		//remove out of screen fireball
-
-		int len = (int)hero_projectiles.size() - 1;
-		for (int i = len; i >= 0; i--)
-		{
-			Projectile* h_proj = hero_projectiles.at(i);
-			if (h_proj->get_position().x < 0.f || h_proj->get_position().x > screen.x || h_proj->get_position().y < 0.f || h_proj->get_position().y > screen.y)
-			{
-				h_proj->destroy();
-				hero_projectiles.erase(hero_projectiles.begin() + i);
-				continue;
-			}
-		}
-
-		//remove out of screen lasers
-		auto e_proj = enemy_projectiles.begin();
-		while (e_proj != enemy_projectiles.end())
-		{
-			if (e_proj->get_position().x < 0.f || e_proj->get_position().x > screen.x || e_proj->get_position().y < 0.f || e_proj->get_position().y > screen.y)
-			{
-				e_proj->destroy();
-				e_proj = enemy_projectiles.erase(e_proj);
-				continue;
-			}
-
-			++e_proj;
-		}
-
-		//remove overtime thunder
-		len = (int)thunders.size() - 1;
-		for (int i = len; i >= 0; i--)
-		{
-			Thunder* t = thunders.at(i);
-
-			if (t->can_remove())
-			{
-				t->destroy();
-				thunders.erase(thunders.begin() + i);
-				continue;
+				m_hero.set_position(new_position);
 			}
-		}
 
-		//remove overtime phoenix
-		len = (int)phoenix_list.size() - 1;
-		for (int i = len; i >= 0; i--)
-		{
-			phoenix* p = phoenix_list.at(i);
-
-			if (!p->is_alive())
+			// if hero projectile hit the tree trunck then destroy it
+			for (auto h_proj : hero_projectiles)
 			{
-				p->destroy(true);
-				phoenix_list.erase(phoenix_list.begin() + i);
-				continue;
+				if (!h_proj->is_removed() && treeTrunk.collide_with(*h_proj))
+					h_proj->mark_removed();
 			}
-		}
-
-		vec2 dangerPos = {NULL, NULL};
-
-		auto enemy = m_enemys_01.begin();
 
-		while (enemy != m_enemys_01.end())
-		{
-			int len = (int)hero_projectiles.size() - 1;
-			for (int i = len; i >= 0; i--)
+			//same for enemy projectile
+			for (auto& laser : enemy_projectiles)
 			{
-				Projectile* h_proj = hero_projectiles.at(i);
-				if (enemy->collide_with(*h_proj))
-				{
-					enemy->take_damage(h_proj->get_damage(), h_proj->get_velocity());
-					dangerPos = {enemy->get_position().x, enemy->get_position().y};
-
-					h_proj->destroy();
-					hero_projectiles.erase(hero_projectiles.begin() + i);
-					if (!enemy->is_alive()) {
-						enemy->destroy(true);
-						enemy = m_enemys_01.erase(enemy);
-						if (!passed_level){
-							++m_points;
-						}
-						MAX_ENEMIES_01 = INIT_MAX_ENEMIES + (m_points / 23);
-					}
-					break;
-				}
-
-			}
-
-			if (enemy == m_enemys_01.end() || m_enemys_01.size() == 0) {
-				break;
+				if (!laser.is_removed() && treeTrunk.collide_with(laser))
+					laser.mark_removed();
 			}
-			++enemy;
 		}
 
-		enemy = m_enemys_01.begin();
+		//check collision between phoenix and enemies
 
-		while (enemy != m_enemys_01.end())
+		//remove out of screen fireball
+		for (auto h_proj : hero_projectiles)
 		{
-			int len = (int)thunders.size() - 1;
-			for (int i = len; i >= 0; i--)
-			{
-				Thunder* t = thunders.at(i);
-				if (enemy->collide_with(*t))
-				{
-					t->apply_effect(*enemy);
-					dangerPos = {enemy->get_position().x, enemy->get_position().y};
-
-					if (!enemy->is_alive()) {
-						enemy->destroy(true);
-						enemy = m_enemys_01.erase(enemy);
-						if (!passed_level){
-							++m_points;
-						}
-						MAX_ENEMIES_01 = INIT_MAX_ENEMIES + m_points / 23;
-					}
-					break;
-				}
-
-			}
-
-			if (enemy == m_enemys_01.end() || m_enemys_01.size() == 0) {
-				break;
-			}
-			++enemy;
+			if (h_proj->get_position().x < 0.f || h_proj->get_position().x > screen.x || h_proj->get_position().y < 0.f || h_proj->get_position().y > screen.y)
+				h_proj->mark_removed();
 		}
 
-		auto enemy2 = m_enemys_02.begin();
-
-		while (enemy2 != m_enemys_02.end())
+		//remove out of screen lasers
+		for (auto& e_proj : enemy_projectiles)
 		{
-			int len = (int)hero_projectiles.size() - 1;
-			for (int i = len; i >= 0; i--)
-			{
-				Projectile* h_proj = hero_projectiles.at(i);
-				if (enemy2->collide_with(*h_proj))
-				{
-					enemy2->take_damage(h_proj->get_damage(), h_proj->get_velocity());
-					dangerPos = {enemy2->get_position().x, enemy2->get_position().y};
-					h_proj->destroy();
-					hero_projectiles.erase(hero_projectiles.begin() + i);
-					if (!enemy2->is_alive()) {
-						enemy2->destroy(true);
-						enemy2 = m_enemys_02.erase(enemy2);
-						if (!passed_level){
-							++m_points;
-						}
-						MAX_ENEMIES_02 = INIT_MAX_ENEMIES + (m_points / 19);
-					}
-					break;
-				}
-			}
-			if (enemy2 == m_enemys_02.end() || m_enemys_02.size() == 0) {
-				break;
-			}
-			++enemy2;
+			if (e_proj.get_position().x < 0.f || e_proj.get_position().x > screen.x || e_proj.get_position().y < 0.f || e_proj.get_position().y > screen.y)
+				e_proj.mark_removed();
 		}
 
-		enemy2 = m_enemys_02.begin();
+		vec2 dangerPos = {NULL, NULL};
 
-		while (enemy2 != m_enemys_02.end())
+		// Hero attacks against enemies go through a uniform grid broadphase, rebuilt for each
+		// kind of attack, and each attack kind is one pass over the packed enemies.
+		// The grid is queried for every enemy at once on the JobSystem, hits are then applied
+		// in enemy order on this thread so the outcome doesn't depend on the scheduling.
+		// Killed enemies and spent projectiles stay in their lists until remove_dead_entities().
+		m_collision_grid.clear();
+		for (int i = 0; i < (int)hero_projectiles.size(); ++i)
 		{
-			int len = (int)thunders.size() - 1;
-			for (int i = len; i >= 0; i--)
-			{
-				Thunder* t = thunders.at(i);
-				if (enemy2->collide_with(*t))
-				{
-					t->apply_effect(*enemy2);
-					dangerPos = {enemy2->get_position().x, enemy2->get_position().y};
-
-					if (!enemy2->is_alive()) {
-						enemy2->destroy(true);
-						enemy2 = m_enemys_02.erase(enemy2);
-						if (!passed_level){
-							++m_points;
-						}
-						MAX_ENEMIES_02 = INIT_MAX_ENEMIES + m_points / 19;
-					}
-					break;
-				}
-
-			}
-
-			if (enemy2 == m_enemys_02.end() || m_enemys_02.size() == 0) {
-				break;
-			}
-			++enemy2;
+			if (hero_projectiles[i]->is_removed())
+				continue;
+			vec2 box = hero_projectiles[i]->get_bounding_box();
+			m_collision_grid.insert(i, hero_projectiles[i]->get_position(), std::max(box.x, box.y));
 		}
+		query_enemy_candidates();
 
-		auto enemy3 = m_enemys_03.begin();
-
-		while (enemy3 != m_enemys_03.end())
+		for (size_t e = 0; e < m_enemy_store.size(); ++e)
 		{
-			int len = (int)hero_projectiles.size() - 1;
-			for (int i = len; i >= 0; i--)
+			if (!m_enemy_store.alive[e])
+				continue;
+
+			for (int i : m_enemy_candidates[e])
 			{
 				Projectile* h_proj = hero_projectiles.at(i);
-				if (enemy3->collide_with(*h_proj))
+				Enemies& enemy = m_enemy_store.get(e);
+				if (!h_proj->is_removed() && enemy.collide_with(*h_proj))
 				{
-					enemy3->take_damage(h_proj->get_damage(), h_proj->get_velocity());
-					dangerPos = {enemy3->get_position().x, enemy3->get_position().y};
-					h_proj->destroy();
-					hero_projectiles.erase(hero_projectiles.begin() + i);
-					if (!enemy3->is_alive()) {
-						enemy3->destroy(true);
-						enemy3 = m_enemys_03.erase(enemy3);
-						if (!passed_level){
-							++m_points;
-						}
-						MAX_ENEMIES_03 = INIT_MAX_ENEMY_03 + (m_points / 41);
-					}
+					enemy.take_damage(h_proj->get_damage(), h_proj->get_velocity());
+					dangerPos = m_enemy_store.positions[e];
+					h_proj->mark_removed();
+					if (!m_enemy_store.update_alive(e) && !passed_level)
+						count_kill(m_enemy_store.kinds[e]);
 					break;
 				}
 			}
-			if (enemy3 == m_enemys_03.end() || m_enemys_03.size() == 0) {
-				break;
-			}
-			++enemy3;
 		}
 
-		enemy3 = m_enemys_03.begin();
+		// Overtime thunders are left out, they are removed at the end of the tick
+		m_collision_grid.clear();
+		for (int i = 0; i < (int)thunders.size(); ++i)
+		{
+			if (!thunders[i]->can_remove())
+				m_collision_grid.insert(i, thunders[i]->get_position(), thunders[i]->get_radius());
+		}
+		query_enemy_candidates();
 
-		while (enemy3 != m_enemys_03.end())
+		for (size_t e = 0; e < m_enemy_store.size(); ++e)
 		{
-			int len = (int)thunders.size() - 1;
-			for (int i = len; i >= 0; i--)
+			if (!m_enemy_store.alive[e])
+				continue;
+
+			for (int i : m_enemy_candidates[e])
 			{
 				Thunder* t = thunders.at(i);
-				if (enemy3->collide_with(*t))
+				Enemies& enemy = m_enemy_store.get(e);
+				if (enemy.collide_with(*t))
 				{
-					t->apply_effect(*enemy3);
-					dangerPos = {enemy3->get_position().x, enemy3->get_position().y};
-
-					if (!enemy3->is_alive()) {
-						enemy3->destroy(true);
-						enemy3 = m_enemys_03.erase(enemy3);
-						if (!passed_level){
-							++m_points;
-						}
-						MAX_ENEMIES_03 = INIT_MAX_ENEMIES + m_points / 41;
-					}
+					t->apply_effect(enemy);
+					dangerPos = m_enemy_store.positions[e];
+					if (!m_enemy_store.update_alive(e) && !passed_level)
+						count_kill(m_enemy_store.kinds[e]);
 					break;
 				}
-
-			}
-
-			if (enemy3 == m_enemys_03.end() || m_enemys_03.size() == 0) {
-				break;
 			}
-			++enemy3;
 		}
 
 		//check collision with phoenix
 
-		enemy = m_enemys_01.begin();
-
-		while (enemy != m_enemys_01.end())
+		m_collision_grid.clear();
+		for (int i = 0; i < (int)phoenix_list.size(); ++i)
 		{
-			int len = (int)phoenix_list.size() - 1;
-			for (int i = len; i >= 0; i--)
-			{
-				phoenix* p = phoenix_list.at(i);
-				if (p->collide_with(*enemy))
-				{
-					dangerPos = {enemy->get_position().x, enemy->get_position().y};
-					p->change_hp(-1.f);
-					enemy->take_damage(6.f);
-
-					if (!enemy->is_alive()) {
-						enemy->destroy(true);
-						enemy = m_enemys_01.erase(enemy);
-						++m_points;
-						MAX_ENEMIES_01 = INIT_MAX_ENEMIES + m_points / 23;
-					}
-					break;
-				}
-
-			}
-
-			if (enemy == m_enemys_01.end() || m_enemys_01.size() == 0) {
-				break;
-			}
-			++enemy;
+			if (!phoenix_list[i]->is_alive())
+				continue;
+			vec2 box = phoenix_list[i]->get_bounding_box();
+			m_collision_grid.insert(i, phoenix_list[i]->get_position(), std::max(box.x, box.y));
 		}
+		query_enemy_candidates();
 
-		enemy2 = m_enemys_02.begin();
-
-		while (enemy2 != m_enemys_02.end())
+		for (size_t e = 0; e < m_enemy_store.size(); ++e)
 		{
-			int len = (int)phoenix_list.size() - 1;
-			for (int i = len; i >= 0; i--)
-			{
-				phoenix* p = phoenix_list.at(i);
-				if (p->collide_with(*enemy2))
-				{
-					dangerPos = {enemy2->get_position().x, enemy2->get_position().y};
-					p->change_hp(-1.f);
-					enemy2->take_damage(6.f);
-
-					if (!enemy2->is_alive()) {
-						enemy2->destroy(true);
-						enemy2 = m_enemys_02.erase(enemy2);
-						++m_points;
-						MAX_ENEMIES_02 = INIT_MAX_ENEMIES + m_points / 19;
-					}
-					break;
-				}
-
-			}
-
-			if (enemy2 == m_enemys_02.end() || m_enemys_02.size() == 0) {
-				break;
-			}
-			++enemy2;
-		}
-
-		enemy3 = m_enemys_03.begin();
+			if (!m_enemy_store.alive[e])
+				continue;
 
-		while (enemy3 != m_enemys_03.end())
-		{
-			int len = (int)phoenix_list.size() - 1;
-			for (int i = len; i >= 0; i--)
+			for (int i : m_enemy_candidates[e])
 			{
 				phoenix* p = phoenix_list.at(i);
-				if (p->collide_with(*enemy3))
+				Enemies& enemy = m_enemy_store.get(e);
+				if (p->collide_with(enemy))
 				{
-					dangerPos = {enemy3->get_position().x, enemy3->get_position().y};
+					dangerPos = m_enemy_store.positions[e];
 					p->change_hp(-1.f);
-					enemy3->take_damage(6.f);
+					enemy.take_damage(6.f);
 
-					if (!enemy3->is_alive()) {
-						enemy3->destroy(true);
-						enemy3 = m_enemys_03.erase(enemy3);
-						++m_points;
-						MAX_ENEMIES_03 = INIT_MAX_ENEMIES + m_points / 41;
-					}
+					// Phoenix kills still count once the level is passed
+					if (!m_enemy_store.update_alive(e))
+						count_kill(m_enemy_store.kinds[e]);
 					break;
 				}
-
-			}
-
-			if (enemy3 == m_enemys_03.end() || m_enemys_03.size() == 0) {
-				break;
 			}
-			++enemy3;
 		}
 
 		//check collision between phoenix and enemy laser
-		l_len = (int)enemy_projectiles.size() - 1;
-		for (int i = l_len; i >= 0; i--)
+		for (auto& laser : enemy_projectiles)
 		{
-			EnemyLaser &laser = enemy_projectiles.at(i);
+			if (laser.is_removed())
+				continue;
+
 			int j_len = (int)phoenix_list.size() - 1;
 			for (int j = j_len; j >= 0; j--)
 			{
 				phoenix* p = phoenix_list.at(j);
-				if (p->collide_with(laser))
+				if (p->is_alive() && p->collide_with(laser))
 				{
 					p->change_hp(-10.f);
-					laser.destroy();
-					enemy_projectiles.erase(enemy_projectiles.begin() + i);
+					laser.mark_removed();
 					break;
 				}
 			}
-
 		}
 
-
+		remove_dead_entities();
 
 		// Spawning new enemys
 		if (!passed_level){
@@ -1403,18 +1106,7 @@ bool World::update(float elapsed_ms)
 				if (!spawn_enemy_01())
 					return false;
 
-				Enemy_01& new_enemy = m_enemys_01.back();
-
-				int left_or_right_spawn = rand() % 2;
-
-				float screen_x = 0;
-
-				if (left_or_right_spawn == 0) {
-					screen_x = screen.x + 150.f;
-				}
-
-				// Setting random initial position
-				new_enemy.set_position({ screen_x, 50 + m_dist(m_rng) * (screen.y - 100) });
+				place_spawned_enemy(m_enemys_01.back(), screen);
 
 				// Next spawn
 				m_next_enemy1_spawn = m_dist(m_rng) * (ENEMY_DELAY_MS)-log(m_points + 1) * 300;
@@ -1425,18 +1117,7 @@ bool World::update(float elapsed_ms)
 				if (!spawn_enemy_02())
 					return false;
 
-				Enemy_02& new_enemy = m_enemys_02.back();
-
-				int left_or_right_spawn = rand() % 2;
-
-				float screen_x = 0;
-
-				if (left_or_right_spawn == 0) {
-					screen_x = screen.x + 150.f;
-				}
-
-				// Setting random initial position
-				new_enemy.set_position({ screen_x, 50 + m_dist(m_rng) * (screen.y - 100) });
+				place_spawned_enemy(m_enemys_02.back(), screen);
 
 				// Next spawn
 				m_next_enemy2_spawn = m_dist(m_rng) * (ENEMY_DELAY_MS)-log(m_points + 1) * 300;
@@ -1448,18 +1129,7 @@ bool World::update(float elapsed_ms)
 				if (!spawn_enemy_03())
 					return false;
 
-				Enemy_03& new_enemy = m_enemys_03.back();
-
-				int left_or_right_spawn = rand() % 2;
-
-				float screen_x = 0;
-
-				if (left_or_right_spawn == 0) {
-					screen_x = screen.x + 150.f;
-				}
-
-				// Setting random initial position
-				new_enemy.set_position({ screen_x, 50 + m_dist(m_rng) * (screen.y - 100) });
+				place_spawned_enemy(m_enemys_03.back(), screen);
 
 				// Next spawn
 				m_next_enemy3_spawn = m_dist(m_rng) * (ENEMY_03_DELAY_MS)-log(m_points + 1) * 300;
@@ -1467,12 +1137,7 @@ bool World::update(float elapsed_ms)
 		}
 
 		if(dangerPos.x != NULL && dangerPos.y != NULL) {
-			for (auto& enemy : m_enemys_01)
-				enemy.set_dangerPos({dangerPos.x, dangerPos.y});
-			for (auto& enemy : m_enemys_02)
-				enemy.set_dangerPos({dangerPos.x, dangerPos.y});
-			for (auto& enemy : m_enemys_03)
-				enemy.set_dangerPos({dangerPos.x, dangerPos.y});
+			for_each_enemy([&dangerPos](Enemies& enemy) { enemy.set_dangerPos({dangerPos.x, dangerPos.y}); });
 		}
 	}
 
@@ -1482,7 +1147,7 @@ bool World::update(float elapsed_ms)
 	if (!m_hero.is_alive() &&
 		m_water.get_salmon_dead_time() > 5) {
 		int w, h;
-		glfwGetWindowSize(m_window, &w, &h);
+		get_window_size(w, h);
 		stree.destroy();
 		start.destroy();
 		m_interface.destroy();
@@ -1519,7 +1184,7 @@ bool World::update(float elapsed_ms)
 		for (auto& thunder : thunders)
 			thunder->destroy();
 		for (auto& phoenix : phoenix_list)
-			phoenix->destroy(true);
+			phoenix->destroy();
 		for (auto& vine : m_vine)
 			vine.destroy();
 		for (auto& box : m_box)
@@ -1627,19 +1292,20 @@ bool World::update(float elapsed_ms)
 
 // Render our game world
 // http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-14-render-to-texture/
-void World::draw()
+void World::draw(float alpha)
 {
 	// Clearing error buffer
 	gl_flush_errors();
 
+	// Camera and sprites follow the blended positions, simulation resumes from the real ones
+	apply_render_positions(alpha);
+
+	// Loading and destroying between frames bypass the state tracker, start from scratch
+	GLState::instance().begin_frame();
+
 	// Getting size of window
 	int w, h;
-	glfwGetFramebufferSize(m_window, &w, &h);
-
-	// Updating window title with points
-	std::stringstream title_ss;
-	title_ss << "Points: " << m_points << "  HP: " << (int) m_hero.get_hp() << "  MP: " << (int) m_hero.get_mp() << "  Level: " << m_game_level ;
-	glfwSetWindowTitle(m_window, title_ss.str().c_str());
+	get_framebuffer_size(w, h);
 
 	/////////////////////////////////////
 	// First render to the custom framebuffer
@@ -1694,6 +1360,7 @@ void World::draw()
 	mat3 translate_2D{ { 1.f, 0.f, 0.f },{ 0.f, 1.f, 0.f },{ tx, ty, 1.f} };
 
 	mat3 projection_2D = mul(translate_2D, scaling_2D);
+	SpriteBatch::instance().begin(projection_2D);
 
 	start.draw(projection_2D);
 
@@ -1733,32 +1400,42 @@ void World::draw()
 
 	// Drawing entities
 	if (start_is_over && !shopping) {
-		map.draw(projection_2D);
-		m_hero.draw(projection_2D);	// TODO if problems, refer to this line
+		// The queue orders these by layer then state, submission order does not matter. Kinds that
+		// overlap within a layer get decreasing depths in the order they used to be drawn, so
+		// which one ends on top never depends on the GL names of their programs and textures.
+		RenderQueue& queue = RenderQueue::instance();
+		// Entities live in unzoomed world coordinates, the camera rect is zoomed
+		queue.set_view({ screen_left / zoom_factor, screen_top / zoom_factor }, { screen_right / zoom_factor, screen_bottom / zoom_factor });
+		queue.submit(map, RenderQueue::LAYER_BACKGROUND);
+		queue.submit(m_hero, RenderQueue::LAYER_ACTORS, 0.75f);
 		for (auto& enemy : m_enemys_01)
-			enemy.draw(projection_2D);
+			queue.submit(enemy, RenderQueue::LAYER_ACTORS, enemy.get_position(), enemy.get_bounding_box(), 0.5f);
 		for (auto& enemy : m_enemys_02)
-			enemy.draw(projection_2D);
+			queue.submit(enemy, RenderQueue::LAYER_ACTORS, enemy.get_position(), enemy.get_bounding_box(), 0.25f);
 		for (auto& enemy : m_enemys_03)
-			enemy.draw(projection_2D);
+			queue.submit(enemy, RenderQueue::LAYER_ACTORS, enemy.get_position(), enemy.get_bounding_box(), 0.f);
 		for (auto& h_proj : hero_projectiles)
-			h_proj->draw(projection_2D);
+			queue.submit(*h_proj, RenderQueue::LAYER_PROJECTILES, h_proj->get_position(), h_proj->get_bounding_box());
 		for (auto& e_proj : enemy_projectiles)
-			e_proj.draw(projection_2D);
+			queue.submit(e_proj, RenderQueue::LAYER_PROJECTILES, e_proj.get_position(), e_proj.get_bounding_box());
+		// Bolts are drawn from the top of the screen down to their target, never culled
 		for (auto& thunder : thunders)
-			thunder->draw(projection_2D);
-
+			queue.submit(*thunder, RenderQueue::LAYER_EFFECTS);
+		// Trunks under the canopies, boxes under the portal
 		for (auto& treetrunk : m_treetrunk)
-			treetrunk.draw(projection_2D);
+			queue.submit(treetrunk, RenderQueue::LAYER_SCENERY, 0.8f);
 		for (auto& tree : m_tree)
-			tree.draw(projection_2D);
+			queue.submit(tree, RenderQueue::LAYER_SCENERY, tree.get_position(), tree.get_bounding_box(), 0.6f);
+		// Their bounding boxes are hitboxes smaller than the sprite, culling on them would pop
 		for (auto& vine : m_vine)
-			vine.draw(projection_2D);
+			queue.submit(vine, RenderQueue::LAYER_SCENERY, 0.4f);
 		for (auto& box : m_box)
-			box.draw(projection_2D);
-		m_portal.draw(projection_2D);
+			queue.submit(box, RenderQueue::LAYER_SCENERY, 0.2f);
+		queue.submit(m_portal, RenderQueue::LAYER_SCENERY, 0.f);
 		for (auto& phoenix : phoenix_list)
-			phoenix->draw(projection_2D);
+			queue.submit(*phoenix, RenderQueue::LAYER_SUMMONS);
+		queue.flush(projection_2D);
+
 		m_interface.draw(projection_2D);
 		hme.draw(projection_2D);
 		ingame.draw(projection_2D);
@@ -1780,6 +1457,8 @@ void World::draw()
 		skill_text.RenderText(projection_2D, "Skill points left " + std::to_string(remaining_skills), 90.f, 90.f, 0.5f, vec3{ 0.8f, 0.7f, 0.2f });
 		button_back_from_skillscreen.draw(projection_2D);
 	}
+	restore_simulated_positions();
+
 	/////////////////////
 	// Truely render to the screen
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -1792,31 +1471,256 @@ void World::draw()
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	// Bind our texture in Texture Unit 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, m_screen_tex.id);
+	GLState::instance().bind_texture(0, m_screen_tex.id);
 
 	m_water.draw(projection_2D);
 
+	// Updating window title with points
+	std::stringstream title_ss;
+	title_ss << "Points: " << m_points << "  HP: " << (int) m_hero.get_hp() << "  MP: " << (int) m_hero.get_mp() << "  Level: " << m_game_level ;
+	// Counters of the frame just drawn, only when profiling with --stats
+	if (m_show_stats)
+	{
+		title_ss << "  Drawn: " << RenderQueue::instance().get_command_count() << " entities, " << SpriteBatch::instance().get_sprite_count()
+			<< " sprites in " << SpriteBatch::instance().get_draw_calls() << " draws"
+			<< "  Culled: " << RenderQueue::instance().get_culled_count() << " entities, " << SpriteBatch::instance().get_culled_count() << " sprites";
+		const GLState::Counters& gl_counters = GLState::instance().get_counters();
+		title_ss << "  GL state changes: " << gl_counters.total() << " (" << gl_counters.elided << " elided)";
+	}
+	glfwSetWindowTitle(m_window, title_ss.str().c_str());
+
 	//////////////////
 	// Presenting
 	glfwSwapBuffers(m_window);
 }
 
+void World::set_show_stats(bool show)
+{
+	m_show_stats = show;
+}
+
 // Should the game be over ?
 bool World::is_over()const
 {
+	if (m_player.is_finished(m_tick))
+		return true;
+	if (m_headless)
+		return false;
 	return glfwWindowShouldClose(m_window);
 }
 
+// Slides every enemy touching an obstacle around it, on the side facing away from the hero
+void World::steer_enemies_around_obstacles(float elapsed_ms)
+{
+	if (m_obstacle_field.empty())
+		return;
+
+	vec2 hero_position = m_hero.get_position();
+	for (size_t e = 0; e < m_enemy_store.size(); ++e)
+	{
+		// Store radii are full sprite extents, the field distance is to the enemy center
+		vec2 cur_position = m_enemy_store.positions[e];
+		ObstacleField::Sample sample;
+		if (!m_obstacle_field.sample(cur_position, sample) || sample.distance >= m_enemy_store.radii[e] * 0.5f)
+			continue;
+
+		// Tangent turning away from the hero, only the side of the hero matters
+		vec2 normal = sample.normal;
+		vec2 diffHero = { cur_position.x - hero_position.x, cur_position.y - hero_position.y };
+		vec2 tangent;
+		if (normal.x * diffHero.y - normal.y * diffHero.x < 0.f)
+			tangent = { -normal.y, normal.x };
+		else
+			tangent = { normal.y, -normal.x };
+
+		float stepback = elapsed_ms * sample.push;
+		vec2 new_position = { cur_position.x + (tangent.x + normal.x) * stepback, cur_position.y + (tangent.y + normal.y) * stepback };
+		m_enemy_store.set_position(e, new_position);
+	}
+}
+
+void World::on_live_input(const InputEvent& event)
+{
+	// The replay drives the game, anything done meanwhile would desync it
+	if (m_player.is_playing())
+		return;
+
+	if (m_recorder.is_recording())
+	{
+		InputEvent stamped = event;
+		stamped.tick = m_tick;
+		m_recorder.record(stamped);
+	}
+	dispatch_input(event);
+}
+
+void World::dispatch_input(const InputEvent& event)
+{
+	switch (event.type)
+	{
+	case InputEvent::KEY:
+		on_key(m_window, event.code, event.scancode, event.action, event.mods);
+		break;
+	case InputEvent::MOUSE_MOVE:
+		on_mouse_move(m_window, event.x, event.y);
+		break;
+	case InputEvent::MOUSE_BUTTON:
+		on_mouse_click(m_window, event.code, event.action, event.mods);
+		break;
+	case InputEvent::MOUSE_WHEEL:
+		on_mouse_wheel(m_window, event.x, event.y);
+		break;
+	default:
+		break;
+	}
+}
+
+void World::seed_random(uint32_t rand_seed, uint32_t rng_seed)
+{
+	game_srand(rand_seed);
+	m_rng.seed(rng_seed);
+	m_dist.reset();
+}
+
+void World::get_framebuffer_size(int& w, int& h)const
+{
+	if (m_headless)
+	{
+		w = (int)m_window_width;
+		h = (int)m_window_height;
+		return;
+	}
+	glfwGetFramebufferSize(m_window, &w, &h);
+}
+
+void World::get_window_size(int& w, int& h)const
+{
+	if (m_headless)
+	{
+		w = (int)m_window_width;
+		h = (int)m_window_height;
+		return;
+	}
+	glfwGetWindowSize(m_window, &w, &h);
+}
+
+void World::save_previous_positions()
+{
+	m_hero.previous_position.save(m_hero.get_position());
+	for_each_enemy([](Enemies& enemy) { enemy.previous_position.save(enemy.get_position()); });
+	for (auto h_proj : hero_projectiles)
+		h_proj->previous_position.save(h_proj->get_position());
+	for (auto& e_proj : enemy_projectiles)
+		e_proj.previous_position.save(e_proj.get_position());
+}
+
+void World::apply_render_positions(float alpha)
+{
+	// Same order as restore_simulated_positions(), nothing spawns or dies in between
+	m_simulated_positions.clear();
+	auto apply = [this, alpha](const PreviousPosition& previous, vec2 current) {
+		m_simulated_positions.push_back(current);
+		return previous.blend(current, alpha);
+	};
+
+	m_hero.set_position(apply(m_hero.previous_position, m_hero.get_position()));
+	for_each_enemy([&apply](Enemies& enemy) { enemy.set_position(apply(enemy.previous_position, enemy.get_position())); });
+	for (auto h_proj : hero_projectiles)
+		h_proj->set_position(apply(h_proj->previous_position, h_proj->get_position()));
+	for (auto& e_proj : enemy_projectiles)
+		e_proj.set_position(apply(e_proj.previous_position, e_proj.get_position()));
+}
+
+void World::restore_simulated_positions()
+{
+	size_t i = 0;
+	m_hero.set_position(m_simulated_positions[i++]);
+	for_each_enemy([this, &i](Enemies& enemy) { enemy.set_position(m_simulated_positions[i++]); });
+	for (auto h_proj : hero_projectiles)
+		h_proj->set_position(m_simulated_positions[i++]);
+	for (auto& e_proj : enemy_projectiles)
+		e_proj.set_position(m_simulated_positions[i++]);
+}
+
+void World::query_enemy_candidates()
+{
+	if (m_enemy_candidates.size() < m_enemy_store.size())
+		m_enemy_candidates.resize(m_enemy_store.size());
+
+	// Each range only writes the candidate lists of its own enemies
+	JobSystem::instance().parallel_for(m_enemy_store.size(), 16, [this](size_t begin, size_t end) {
+		for (size_t e = begin; e < end; ++e)
+		{
+			if (m_enemy_store.alive[e])
+				m_collision_grid.query_shared(m_enemy_store.positions[e], m_enemy_store.radii[e], m_enemy_candidates[e]);
+			else
+				m_enemy_candidates[e].clear();
+		}
+	});
+}
+
+void World::count_kill(uint8_t kind)
+{
+	++m_points;
+	switch (kind)
+	{
+	case EnemyStore::KIND_01:
+		MAX_ENEMIES_01 = INIT_MAX_ENEMIES + m_points / 23;
+		break;
+	case EnemyStore::KIND_02:
+		MAX_ENEMIES_02 = INIT_MAX_ENEMIES + m_points / 19;
+		break;
+	case EnemyStore::KIND_03:
+		MAX_ENEMIES_03 = INIT_MAX_ENEMY_03 + m_points / 41;
+		break;
+	}
+}
+
+// Enemy order is kept since group behaviours pick enemies by index, the
+// other lists are unordered and fill the gaps with their last element
+void World::remove_dead_entities()
+{
+	auto dead_enemy = [](Enemies& enemy) {
+		if (enemy.is_alive())
+			return false;
+		enemy.destroy(true);
+		return true;
+	};
+	compact_if(m_enemys_01, dead_enemy);
+	compact_if(m_enemys_02, dead_enemy);
+	compact_if(m_enemys_03, dead_enemy);
+
+	swap_and_pop_if(hero_projectiles, [](Projectile* h_proj) {
+		if (!h_proj->is_removed())
+			return false;
+		h_proj->destroy();
+		return true;
+	});
+	swap_and_pop_if(enemy_projectiles, [](EnemyLaser& e_proj) {
+		if (!e_proj.is_removed())
+			return false;
+		e_proj.destroy();
+		return true;
+	});
+	swap_and_pop_if(thunders, [](Thunder* t) {
+		if (!t->can_remove())
+			return false;
+		t->destroy();
+		return true;
+	});
+	swap_and_pop_if(phoenix_list, [](phoenix* p) {
+		if (p->is_alive())
+			return false;
+		p->destroy();
+		return true;
+	});
+}
+
 // Creates a new enemy and if successfull adds it to the list of enemys
 bool World::spawn_enemy_01()
 {
-	Enemy_01 enemy;
-	if (enemy.init(m_points))
-	{
-		m_enemys_01.emplace_back(enemy);
+	if (emplace_initialized(m_enemys_01, m_points))
 		return true;
-	}
 	fprintf(stderr, "Failed to spawn enemy 01");
 	return false;
 }
@@ -1824,12 +1728,8 @@ bool World::spawn_enemy_01()
 // Creates a new enemy and if successfull adds it to the list of enemys
 bool World::spawn_enemy_02()
 {
-	Enemy_02 enemy;
-	if (enemy.init(m_points))
-	{
-		m_enemys_02.emplace_back(enemy);
+	if (emplace_initialized(m_enemys_02, m_points))
 		return true;
-	}
 	fprintf(stderr, "Failed to spawn enemy 02");
 	return false;
 }
@@ -1838,25 +1738,31 @@ bool World::spawn_enemy_02()
 // Creates a new enemy and if successfull adds it to the list of enemys
 bool World::spawn_enemy_03()
 {
-	Enemy_03 enemy;
-	if (enemy.init(m_points))
-	{
-		m_enemys_03.emplace_back(enemy);
+	if (emplace_initialized(m_enemys_03, m_points))
 		return true;
-	}
 	fprintf(stderr, "Failed to spawn enemy 03");
 	return false;
 }
 
+void World::place_spawned_enemy(Enemies& enemy, vec2 screen)
+{
+	int left_or_right_spawn = game_rand() % 2;
+
+	float screen_x = 0;
+
+	if (left_or_right_spawn == 0) {
+		screen_x = screen.x + 150.f;
+	}
+
+	// Setting random initial position
+	enemy.set_position({ screen_x, 50 + m_dist(m_rng) * (screen.y - 100) });
+}
+
 
 bool World::spawn_treetrunk()
 {
-	Treetrunk treetrunk;
-	if (treetrunk.init({ m_window_width,m_window_height }))
-	{
-		m_treetrunk.emplace_back(treetrunk);
+	if (emplace_initialized(m_treetrunk, vec2{ m_window_width, m_window_height }))
 		return true;
-	}
 	fprintf(stderr, "Failed to spawn treetrunk");
 	return false;
 }
@@ -1864,36 +1770,24 @@ bool World::spawn_treetrunk()
 
 bool World::spawn_tree()
 {
-	Tree tree;
-	if (tree.init({ m_window_width,m_window_height }))
-	{
-		m_tree.emplace_back(tree);
+	if (emplace_initialized(m_tree, vec2{ m_window_width, m_window_height }))
 		return true;
-	}
 	fprintf(stderr, "Failed to spawn treetrunk");
 	return false;
 }
 
 bool World::spawn_vine()
 {
-	Vine vine;
-	if (vine.init({ m_window_width,m_window_height }))
-	{
-		m_vine.emplace_back(vine);
+	if (emplace_initialized(m_vine, vec2{ m_window_width, m_window_height }))
 		return true;
-	}
 	fprintf(stderr, "Failed to spawn vine");
 	return false;
 }
 
 bool World::spawn_box()
 {
-	Box box;
-	if (box.init({ m_window_width,m_window_height }))
-	{
-		m_box.emplace_back(box);
+	if (emplace_initialized(m_box, vec2{ m_window_width, m_window_height }))
 		return true;
-	}
 	fprintf(stderr, "Failed to spawn box");
 	return false;
 }
@@ -1909,12 +1803,12 @@ void World::on_key(GLFWwindow*, int key, int, int action, int mod)
 
 	// Resetting game
 	int w, h;
-	glfwGetFramebufferSize(m_window, &w, &h);
+	get_framebuffer_size(w, h);
 	vec2 screen = { (float)w, (float)h };
 	if (action == GLFW_RELEASE && key == GLFW_KEY_R && start_is_over == true && shopping == false)
 	{
 		int w, h;
-		glfwGetWindowSize(m_window, &w, &h);
+		get_window_size(w, h);
 		button_play.destroy();
 		button_tutorial.destroy();
 		button_tutorial_next_page.destroy();
@@ -1953,7 +1847,7 @@ void World::on_key(GLFWwindow*, int key, int, int action, int mod)
 		for (auto& thunder : thunders)
 			thunder->destroy();
 		for (auto& phoenix : phoenix_list)
-			phoenix->destroy(true);
+			phoenix->destroy();
 		for (auto& vine : m_vine)
 			vine.destroy();
 		for (auto& box : m_box)
@@ -2128,8 +2022,9 @@ void World::on_key(GLFWwindow*, int key, int, int action, int mod)
 	// }
 	else if (key == GLFW_KEY_ESCAPE && action != GLFW_RELEASE && !start_is_over) {
         if (!display_tutorial && !shopping) {
-            // escape in start screen
-            glfwSetWindowShouldClose(m_window, GL_TRUE);
+            // escape in start screen, a headless replay has no window to close
+            if (m_window != nullptr)
+                glfwSetWindowShouldClose(m_window, GL_TRUE);
         }
 		else if (shopping) {
 			shopping = !shopping;
@@ -2188,7 +2083,7 @@ void World::on_mouse_move(GLFWwindow* window, double xpos, double ypos)
 void World::on_mouse_click(GLFWwindow* window, int button, int action, int mods)
 {
 	int w, h;
-	glfwGetFramebufferSize(m_window, &w, &h);
+	get_framebuffer_size(w, h);
 	vec2 screen = { (float)w, (float)h };
 	if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !start_is_over ) {
 		if (!display_tutorial && !shopping) {
@@ -2391,11 +2286,13 @@ void World::startGame()
 	}
 	// grab screen size first
 	int w, h;
-	glfwGetFramebufferSize(m_window, &w, &h);
+	get_framebuffer_size(w, h);
 	vec2 screen = { (float)w, (float)h };
 
 	// input code from key input, "G"
 	if (start_is_over == false) {
+		// Don't blend the first frame from wherever the hero was before the restart
+		m_hero.previous_position.reset();
 		map.init(screen,m_game_level);
 		start_is_over = true;
 		zoom_factor = 1.1f;
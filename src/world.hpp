@@ -34,6 +34,12 @@
 #include "Shop.h"
 #include "shop_screen.hpp"
 #include "box.hpp"
+#include "spatial_grid.hpp"
+#include "enemy_store.hpp"
+#include "obstacle_field.hpp"
+#include "flow_field.hpp"
+#include "job_system.hpp"
+#include "replay.hpp"
 
 // stlib
 #include <vector>
@@ -51,17 +57,32 @@ public:
 	World();
 	~World();
 
-	// Creates a window, sets up events and begins the game
-	bool init(vec2 screen);
+	// Creates a window, sets up events and begins the game. A headless world has no window,
+	// GPU or audio, for running the simulation alone.
+	bool init(vec2 screen, bool headless = false);
+
+	// Records the random seeds and the input of this session to path, call right after init()
+	bool start_recording(const char* path, float step_ms);
+
+	// Plays back a recorded session in place of the live input, call right after init().
+	// step_ms receives the simulation step the session has to run at to stay in sync.
+	bool start_replay(const char* path, float& step_ms);
+
+	// Leaves the menus for the first level
+	void startGame();
 
 	// Releases all associated resources
 	void destroy();
 
-	// Steps the game ahead by ms milliseconds
+	// Steps the game ahead by ms milliseconds, called with a fixed step by the main loop
 	bool update(float ms);
 
-	// Renders our scene
-	void draw();
+	// Renders our scene, moving entities are drawn at alpha between the previous
+	// update() and the last one
+	void draw(float alpha = 1.f);
+
+	// Adds the rendering counters of every frame to the window title, for profiling (--stats)
+	void set_show_stats(bool show);
 
 	// Should the game be over ?
 	bool is_over()const;
@@ -71,6 +92,22 @@ private:
 	bool spawn_enemy_01();
 	bool spawn_enemy_02();
 	bool spawn_enemy_03();
+
+	// Puts an enemy spawned by the above on the left or right edge of the screen at a random height
+	void place_spawned_enemy(Enemies& enemy, vec2 screen);
+
+	// Calls fn on every enemy, the 01s first, then the 02s and the 03s
+	template <typename Fn>
+	void for_each_enemy(Fn fn)
+	{
+		for (auto& enemy : m_enemys_01)
+			fn(enemy);
+		for (auto& enemy : m_enemys_02)
+			fn(enemy);
+		for (auto& enemy : m_enemys_03)
+			fn(enemy);
+	}
+
 	bool spawn_treetrunk();
 	bool spawn_tree();
 	bool spawn_vine();
@@ -86,9 +123,49 @@ private:
 	void on_mouse_move(GLFWwindow* window, double xpos, double ypos);
 	void on_mouse_click(GLFWwindow* window, int button, int action, int mods);
 	bool initTrees();
+
+	// Destroys and drops every entity marked dead during the tick
+	void remove_dead_entities();
+
+	// Rebuilds m_obstacle_field and m_flow_field from the portal, boxes and trunks currently placed
+	void build_obstacle_field();
+
+	// Slides every enemy touching an obstacle around it, on the side facing away from the hero
+	void steer_enemies_around_obstacles(float elapsed_ms);
+
+	// Remembers where the moving entities are before a simulation step
+	void save_previous_positions();
+
+	// Moves the entities saved above to their blended draw position for the frame and
+	// back to their simulated one afterwards
+	void apply_render_positions(float alpha);
+	void restore_simulated_positions();
+
+	// GLFW window with its GL context and input callbacks, skipped when headless
+	bool init_window(vec2 screen);
+
+	// SDL mixer with the music and sounds, skipped when headless
+	bool init_audio();
+
+	// Size of the window, or of the screen given to init() when headless
+	void get_framebuffer_size(int& w, int& h)const;
+	void get_window_size(int& w, int& h)const;
+
+	// Fills m_enemy_candidates from m_collision_grid for every enemy of the store, in parallel
+	void query_enemy_candidates();
+
+	// Scores a kill and raises the spawn cap of the EnemyStore kind that was killed
+	void count_kill(uint8_t kind);
 	void on_mouse_wheel(GLFWwindow* window, double xoffset, double yoffset);
 
-	void startGame();
+	// Input from the window: recorded when recording, dropped while a replay drives the game
+	void on_live_input(const InputEvent& event);
+
+	// Hands an event to the matching on_* callback
+	void dispatch_input(const InputEvent& event);
+
+	// Restarts game_rand() and the spawn generator
+	void seed_random(uint32_t rand_seed, uint32_t rng_seed);
 
 	vec3 number_to_vec(int number, bool kill);
 
@@ -100,6 +177,13 @@ private:
 private:
 	// Window handle
 	GLFWwindow* m_window;
+	bool m_headless;
+	bool m_show_stats;
+
+	// Input sessions, m_tick counts the update() calls and timestamps the events
+	ReplayRecorder m_recorder;
+	ReplayPlayer m_player;
+	uint32_t m_tick;
 
 	Startscreen start;
     Text map_text;
@@ -206,7 +290,21 @@ private:
 	std::vector<vec2> m_box_position;
 	vec2 mouse_position;
 
-	clock_t lastFireProjectileTime;
+	// Broadphase for hero attacks against enemies, refilled every update
+	SpatialGrid m_collision_grid;
+	std::vector<std::vector<int>> m_enemy_candidates; // grid entries near each EnemyStore row
+	// Entity updates that can run side by side, refilled every update
+	TaskGraph m_update_graph;
+	// Simulated positions of the entities moved by apply_render_positions()
+	std::vector<vec2> m_simulated_positions;
+	// Positions, radii and kinds of the enemies packed for the collision passes, gathered every update
+	EnemyStore m_enemy_store;
+	// Distance to the static obstacles of the level, rebuilt by initTrees()
+	ObstacleField m_obstacle_field;
+	// Enemy paths toward the hero around those obstacles
+	FlowField m_flow_field;
+
+	double lastFireProjectileTime;
 	Button button_play;
 	Button button_tutorial;
 	Button button_tutorial_next_page;